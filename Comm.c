@@ -18,7 +18,9 @@
  */
 
 #include "Comm.h"
+#include "EventHandler.h"
 #include "Modules.h"
+#include "Storage.h"
 
 #include <stdio.h>
 
@@ -26,6 +28,13 @@
 /* Module ID assignment */
 static const Modules_Id_e m_eModuleId = E_MODULES_ID_COMM;
 
+/* Typedef containing all defined event instances in this module */
+typedef enum
+{
+    E_EVENT_INSTANCE_COMM_HANDLEGAPFILLREQUEST_NULL        = 0U,
+    E_EVENT_INSTANCE_COMM_HANDLEGAPFILLREQUEST_REQUESTSIZE = 1U
+} EventInstance_e;
+
 
 /**
  * @brief The function sends event report to external system.
@@ -48,3 +57,33 @@ void Comm_SendEventReport(const uint8_t *in_pu8EventData, uint32_t in_u32DataSiz
 
     return;
 }
+
+/**
+ * @brief The function serves the sequence ranges missed by the external system again from the stored event log.
+ *
+ * @param in_pu8Request      Request data array, COMM_GAPFILL_RANGE_SIZE_IN_BYTES per range
+ * @param in_u32RequestSize  Size of request data in bytes
+ */
+void Comm_HandleGapFillRequest(const uint8_t *in_pu8Request, uint32_t in_u32RequestSize)
+{
+    uint32_t u32IterBytes = COMMON_STARTING_INDEX_OF_ARRAY;
+
+    if (NULL == in_pu8Request)
+    {
+        EventHandler_GenerateEventReport(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_COMM_HANDLEGAPFILLREQUEST_NULL, E_EVENTHANDLER_SEVERITY_MEDIUM, E_EVENTHANDLER_TYPE_NULLARGUMENT);
+        return;
+    }
+
+    if ((0U == in_u32RequestSize) || (0U != (in_u32RequestSize % COMM_GAPFILL_RANGE_SIZE_IN_BYTES)))
+    {
+        EventHandler_GenerateEventReportUserData(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_COMM_HANDLEGAPFILLREQUEST_REQUESTSIZE, E_EVENTHANDLER_SEVERITY_LOW, E_EVENTHANDLER_TYPE_MINDATALENGTH, in_u32RequestSize);
+        return;
+    }
+
+    for (; in_u32RequestSize > u32IterBytes; u32IterBytes += COMM_GAPFILL_RANGE_SIZE_IN_BYTES)
+    {
+        (void) Storage_LoadEventReports(EventHandler_ReadWord(&in_pu8Request[u32IterBytes]), EventHandler_ReadWord(&in_pu8Request[u32IterBytes + COMMON_UINT32_SIZE_IN_BYTES]), Comm_SendEventReport);
+    }
+
+    return;
+}
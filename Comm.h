@@ -22,6 +22,9 @@
 
 #include "Common.h"
 
+/* Gap-fill request: big-endian pairs of the first and the last missing sequence number */
+#define COMM_GAPFILL_RANGE_SIZE_IN_BYTES 8U
+
 /**
  * @brief The function sends event report to external system.
  *
@@ -30,4 +33,12 @@
  */
 void Comm_SendEventReport(const uint8_t *in_pu8EventData, uint32_t in_u32DataSize);
 
+/**
+ * @brief The function serves the sequence ranges missed by the external system again from the stored event log.
+ *
+ * @param in_pu8Request      Request data array, COMM_GAPFILL_RANGE_SIZE_IN_BYTES per range
+ * @param in_u32RequestSize  Size of request data in bytes
+ */
+void Comm_HandleGapFillRequest(const uint8_t *in_pu8Request, uint32_t in_u32RequestSize);
+
 #endif /* __COMM_H__ */
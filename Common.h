@@ -24,6 +24,7 @@
 #define COMMON_STARTING_INDEX_OF_ARRAY   0U
 #define COMMON_FLOAT64_SIZE_IN_BYTES     8U
 #define COMMON_UINT32_SIZE_IN_BYTES      4U
+#define COMMON_UINT64_SIZE_IN_BYTES      8U
 #define COMMON_BYTE_SIZE_IN_BITS         8U
 
 typedef enum
@@ -34,6 +35,7 @@ typedef enum
 
 typedef unsigned char uint8_t;
 typedef unsigned int uint32_t;
+typedef unsigned long long uint64_t;
 typedef double float64_t;
 
 #endif /* __COMMON_H__ */
@@ -14,6 +14,9 @@
  *  @author Michal Durila
  *  @brief This module provides methods for handling and reporting events as well as their statistics.
  *
+ * All the state lives in an EventHandler_Context_s. The functions without a context work with the default
+ * context reporting to Comm and Storage, further contexts with their own sinks are taken from a static pool.
+ *
  * Copyright 2021 Michal Durila, All rights reserved.
  */
 
@@ -22,15 +25,28 @@
 #include "SystemReset.h"
 #include "Comm.h"
 #include "Storage.h"
+#include "EventStatistics.h"
+
+#if defined(EVENTHANDLER_USE_SINK_WORKERS)
+#include "SinkWorker.h"
+
+#include <pthread.h>
+#endif
 
 
 #define OVERFLOW_LIMIT_IN_SECONDS        10.0
 #define REENABLE_REPORTING_AFTER_MINUTES 10.0
 #define SECONDS_IN_MINUTE                60
-#define EVENT_DATA_SIZE_IN_BYTES         28U
+#define EVENT_DATA_SIZE_IN_BYTES         EVENTHANDLER_REPORT_SIZE_IN_BYTES
 #define DUMMY_USER_DATA                  0U
 #define UNINITIALIZED_COUNTER            0U
 #define EXTRACT_ONE_BYTE                 0xFFU
+#define NESTING_DEPTH_IDLE               0U
+#define NESTING_DEPTH_OUTER              1U
+#define MAX_NESTING_DEPTH                3U
+#define DEFERRED_EVENTS_QUEUE_SIZE       8U
+#define DEFERRED_BATCH_EVENTS_SIZE       (2U * EVENTHANDLER_BATCH_MAX_NUMBER_OF_EVENTS)
+#define DEFAULT_CONTEXT_NUMBER_OF_SINKS  2U
 
 /* SRS-005 */
 /* Module ID assignment */
@@ -46,7 +62,40 @@ typedef enum
     E_EVENT_INSTANCE_EVENTHANDLER_GETEVENTSCOUNTER_TYPES                 = 3U,
     E_EVENT_INSTANCE_EVENTHANDLER_GETSTANDBYMODE_TYPES                   = 4U,
     E_EVENT_INSTANCE_EVENTHANDLER_GETENABLEDREPORTING_TYPES              = 5U,
-    E_EVENT_INSTANCE_EVENTHANDLER_SETENABLEDREPORTING_TYPES              = 6U
+    E_EVENT_INSTANCE_EVENTHANDLER_SETENABLEDREPORTING_TYPES              = 6U,
+    E_EVENT_INSTANCE_EVENTHANDLER_ADDFILTERRULE_NULL                     = 7U,
+    E_EVENT_INSTANCE_EVENTHANDLER_ADDFILTERRULE_MODULE                   = 8U,
+    E_EVENT_INSTANCE_EVENTHANDLER_ADDFILTERRULE_RANGE                    = 9U,
+    E_EVENT_INSTANCE_EVENTHANDLER_ADDFILTERRULE_FULL                     = 10U,
+    E_EVENT_INSTANCE_EVENTHANDLER_CREATECONTEXT_SINKS                    = 11U,
+    E_EVENT_INSTANCE_EVENTHANDLER_CREATECONTEXT_FULL                     = 12U,
+    E_EVENT_INSTANCE_EVENTHANDLER_CONTEXTINITIALIZEONSTART_NULL          = 13U,
+    E_EVENT_INSTANCE_EVENTHANDLER_CONTEXTGENERATEEVENTREPORTUSERDATA_NULL = 14U,
+    E_EVENT_INSTANCE_EVENTHANDLER_CONTEXTGETEVENTSCOUNTER_NULL           = 15U,
+    E_EVENT_INSTANCE_EVENTHANDLER_CONTEXTGETSTANDBYMODE_NULL             = 16U,
+    E_EVENT_INSTANCE_EVENTHANDLER_CONTEXTGETENABLEDREPORTING_NULL        = 17U,
+    E_EVENT_INSTANCE_EVENTHANDLER_CONTEXTSETENABLEDREPORTING_NULL        = 18U,
+    E_EVENT_INSTANCE_EVENTHANDLER_CONTEXTGETDROPPEDNESTEDEVENTS_NULL     = 19U,
+    E_EVENT_INSTANCE_EVENTHANDLER_CONTEXTADDFILTERRULE_NULL              = 20U,
+    E_EVENT_INSTANCE_EVENTHANDLER_CONTEXTCOMPILEFILTERRULES_NULL         = 21U,
+    E_EVENT_INSTANCE_EVENTHANDLER_CONTEXTGETEVENTSRATE_NULL              = 22U,
+    E_EVENT_INSTANCE_EVENTHANDLER_GETEVENTSRATE_SEVERITIES               = 23U,
+    E_EVENT_INSTANCE_EVENTHANDLER_GETEVENTSRATE_TYPES                    = 24U,
+    E_EVENT_INSTANCE_EVENTHANDLER_GETEVENTSRATE_WINDOWS                  = 25U,
+    E_EVENT_INSTANCE_EVENTHANDLER_CONTEXTGETHEAVYHITTERS_NULL            = 26U,
+    E_EVENT_INSTANCE_EVENTHANDLER_GETHEAVYHITTERS_NULL                   = 27U,
+    E_EVENT_INSTANCE_EVENTHANDLER_CONTEXTGENERATEEVENTREPORTBATCH_NULL   = 28U,
+    E_EVENT_INSTANCE_EVENTHANDLER_CONTEXTGENERATEEVENTREPORTBATCH_ARRAYS = 29U,
+    E_EVENT_INSTANCE_EVENTHANDLER_CONTEXTGETNEXTSEQUENCENUMBER_NULL      = 30U,
+    E_EVENT_INSTANCE_EVENTHANDLER_CONTEXTGENERATEEVENTREPORTCONTEXTDATA_NULL = 31U,
+    E_EVENT_INSTANCE_EVENTHANDLER_CONTEXTGENERATEEVENTREPORTCONTEXTDATA_DATA = 32U,
+    E_EVENT_INSTANCE_EVENTHANDLER_CONTEXTGENERATEEVENTREPORTCONTEXTDATA_SIZE = 33U,
+    E_EVENT_INSTANCE_EVENTHANDLER_CONTEXTGETDROPPEDCONTEXTDATACOUNTER_NULL = 34U,
+    E_EVENT_INSTANCE_EVENTHANDLER_ADDFILTERRULE_LOCATIONS                = 35U,
+    E_EVENT_INSTANCE_EVENTHANDLER_CONTEXTSETENABLEDRESET_NULL            = 36U,
+    E_EVENT_INSTANCE_EVENTHANDLER_CONTEXTGETSUPPRESSEDRESETSCOUNTER_NULL = 37U,
+    E_EVENT_INSTANCE_EVENTHANDLER_CONTEXTSETTIMESOURCE_NULL              = 38U,
+    E_EVENT_INSTANCE_EVENTHANDLER_ADDFILTERRULE_MEDIUM                   = 39U
 } EventInstance_e;
 
 /* An auxiliary union defined for the conversion of a 64-bit float variable into an array of bytes */
@@ -55,15 +104,122 @@ typedef union {
         uint8_t au8Buffer[COMMON_FLOAT64_SIZE_IN_BYTES];
 } ConversionFloatToByte_u;
 
+/* An event generated while another event was being processed, waiting for its turn */
+typedef struct
+{
+    Modules_Id_e eModuleId;
+    uint32_t u32LocationInModule;
+    EventHandler_Severity_e eSeverity;
+    EventHandler_Type_e eType;
+    uint32_t u32AdditionalData;
+    uint8_t *pu8ContextReport;
+    uint32_t u32ContextDataSize;
+    uint32_t u32NestingDepth;
+    /* Events of a deferred batch in the batch buffer of the context, none for a single event */
+    EventHandler_EventBatch_s sBatch;
+} DeferredEvent_s;
+
+/* Ring of the deferred events */
+typedef struct
+{
+    DeferredEvent_s asEvents[DEFERRED_EVENTS_QUEUE_SIZE];
+    uint32_t u32Head;
+    uint32_t u32NumberOfEvents;
+} DeferredQueue_s;
+
+/* State of one event reporter */
+struct EventHandler_Context_s
+{
+    boolean bIsUsed;
+    EventHandler_Sink_f apfSinks[EVENTHANDLER_MAX_NUMBER_OF_SINKS];
+    uint32_t u32NumberOfSinks;
+
+    /* Whether a MEDIUM event resets the system, otherwise the reset is only counted */
+    boolean bIsEnabledReset;
+    uint32_t u32SuppressedResetsCounter;
+
+    /* Clock of the event times, Timing_GetTime if NULL */
+    EventHandler_TimeSource_f pfTimeSource;
+
+    uint32_t au32EventsCounter[EVENTHANDLER_NUMBER_OF_EVENT_SEVERITIES][EVENTHANDLER_NUMBER_OF_EVENT_TYPES];
+    float64_t af64LastTime[EVENTHANDLER_NUMBER_OF_EVENT_TYPES];
+    boolean abIsStandbyMode[EVENTHANDLER_NUMBER_OF_EVENT_TYPES];
+    boolean abIsEnabledReporting[EVENTHANDLER_NUMBER_OF_EVENT_TYPES];
+    EventStatistics_s sStatistics;
+    EventHitters_s sHitters;
+
+    /* Nesting depth of the event being processed and the queue of events generated meanwhile */
+    uint32_t u32NestingDepth;
+    DeferredQueue_s sDeferredEvents;
+    uint32_t u32DroppedNestedEventsCounter;
+
+    /* Events of the batches deferred meanwhile, released all at once when the context gets idle */
+    Modules_Id_e aeDeferredBatchModuleIds[DEFERRED_BATCH_EVENTS_SIZE];
+    uint32_t au32DeferredBatchLocationsInModule[DEFERRED_BATCH_EVENTS_SIZE];
+    EventHandler_Severity_e aeDeferredBatchSeverities[DEFERRED_BATCH_EVENTS_SIZE];
+    EventHandler_Type_e aeDeferredBatchTypes[DEFERRED_BATCH_EVENTS_SIZE];
+    uint32_t au32DeferredBatchAdditionalData[DEFERRED_BATCH_EVENTS_SIZE];
+    uint32_t u32DeferredBatchEventsSize;
+
+    /* Sequence number of the next composed report */
+    uint32_t u32NextSequenceNumber;
+
+    /* Reports with the context data of the events being processed, released all at once when the context gets idle */
+    uint8_t au8ContextArena[EVENTHANDLER_CONTEXT_ARENA_SIZE_IN_BYTES];
+    uint32_t u32ContextArenaSize;
+    uint32_t u32DroppedContextDataCounter;
+
+    /* Reports of the batch being processed, handed to the sinks at once */
+    boolean bIsBatching;
+    uint8_t au8BatchReports[EVENTHANDLER_BATCH_MAX_NUMBER_OF_EVENTS * EVENT_DATA_SIZE_IN_BYTES];
+    uint32_t u32BatchReportsSize;
+#if defined(EVENTHANDLER_USE_SINK_WORKERS)
+    /* One thread processes the events at a time, the others wait for it except for the sink threads,
+       whose events wait in a queue of their own; the queue lock guards the nesting depth, the queues and the arena */
+    pthread_mutex_t sProcessingLock;
+    pthread_mutex_t sQueueLock;
+    pthread_t sProcessingThread;
+    boolean bAreLocksInitialized;
+    DeferredQueue_s sSinkEvents;
+#endif
+
+    /* Filter rules in the order of their addition and the lookup tables compiled from them */
+    /* Bit (severity * EVENTHANDLER_NUMBER_OF_EVENT_TYPES + type) of an entry selects the event class */
+    EventHandler_FilterRule_s asFilterRules[EVENTHANDLER_FILTER_MAX_NUMBER_OF_RULES];
+    uint32_t u32NumberOfFilterRules;
+    uint32_t au32FilterDropMask[MODULES_NUMBER_OF_IDS][EVENTHANDLER_FILTER_NUMBER_OF_LOCATIONS + 1U];
+    uint32_t au32FilterCountOnlyMask[MODULES_NUMBER_OF_IDS][EVENTHANDLER_FILTER_NUMBER_OF_LOCATIONS + 1U];
+};
+
 static const float64_t m_f64ReenableReportingAfterSeconds = (SECONDS_IN_MINUTE * REENABLE_REPORTING_AFTER_MINUTES) + OVERFLOW_LIMIT_IN_SECONDS;
 
-static uint32_t m_au32EventsCounter[EVENTHANDLER_NUMBER_OF_EVENT_SEVERITIES][EVENTHANDLER_NUMBER_OF_EVENT_TYPES];
-static float64_t m_af64LastTime[EVENTHANDLER_NUMBER_OF_EVENT_TYPES];
-static boolean m_abIsStandbyMode[EVENTHANDLER_NUMBER_OF_EVENT_TYPES];
-static boolean m_abIsEnabledReporting[EVENTHANDLER_NUMBER_OF_EVENT_TYPES];
+/* Context of the functions without a context, set up by EventHandler_InitializeOnStart */
+static EventHandler_Context_s m_sDefaultContext;
 
-static void EventHandler_InitializeBeforeReset(void);
-static void EventHandler_ComposeAndSendReport(float64_t in_f64CurrentTimeInSeconds, Modules_Id_e in_eModuleId, uint32_t in_u32LocationInModule, EventHandler_Severity_e in_eSeverity, EventHandler_Type_e in_eType, uint32_t in_u32AdditionalData);
+/* Pool of the further contexts, they are never released */
+static EventHandler_Context_s m_asContextsPool[EVENTHANDLER_MAX_NUMBER_OF_CONTEXTS];
+
+static void EventHandler_InitializeBeforeReset(EventHandler_Context_s *inout_psContext);
+static float64_t EventHandler_GetTime(const EventHandler_Context_s *in_psContext);
+static void EventHandler_LockQueue(EventHandler_Context_s *inout_psContext);
+static uint8_t *EventHandler_ReserveContextReport(EventHandler_Context_s *inout_psContext, const uint8_t *in_pu8ContextData, uint32_t *inout_pu32ContextDataSize);
+static void EventHandler_UnlockQueue(EventHandler_Context_s *inout_psContext);
+static boolean EventHandler_IsEventDeferred(const EventHandler_Context_s *in_psContext);
+static void EventHandler_BeginProcessing(EventHandler_Context_s *inout_psContext);
+static DeferredEvent_s *EventHandler_AddDeferredEvent(EventHandler_Context_s *inout_psContext, uint32_t in_u32NumberOfEvents);
+static void EventHandler_DeferEvent(EventHandler_Context_s *inout_psContext, Modules_Id_e in_eModuleId, uint32_t in_u32LocationInModule, EventHandler_Severity_e in_eSeverity, EventHandler_Type_e in_eType, uint32_t in_u32AdditionalData, uint8_t *inout_pu8ContextReport, uint32_t in_u32ContextDataSize);
+static void EventHandler_DeferBatch(EventHandler_Context_s *inout_psContext, const EventHandler_EventBatch_s *in_psBatch);
+static boolean EventHandler_TakeDeferredEvent(EventHandler_Context_s *inout_psContext, DeferredEvent_s *out_psDeferredEvent);
+static void EventHandler_ProcessDeferredEvents(EventHandler_Context_s *inout_psContext);
+static void EventHandler_ProcessBatchInChunks(EventHandler_Context_s *inout_psContext, const EventHandler_EventBatch_s *in_psBatch);
+static void EventHandler_ProcessBatch(EventHandler_Context_s *inout_psContext, const EventHandler_EventBatch_s *in_psBatch, uint32_t in_u32FirstEvent, uint32_t in_u32NumberOfEvents);
+static void EventHandler_ProcessEvent(EventHandler_Context_s *inout_psContext, Modules_Id_e in_eModuleId, uint32_t in_u32LocationInModule, EventHandler_Severity_e in_eSeverity, EventHandler_Type_e in_eType, uint32_t in_u32AdditionalData, uint8_t *inout_pu8ContextReport, uint32_t in_u32ContextDataSize);
+static void EventHandler_ForwardEvent(EventHandler_Context_s *inout_psContext, float64_t in_f64CurrentTimeInSeconds, Modules_Id_e in_eModuleId, uint32_t in_u32LocationInModule, EventHandler_Severity_e in_eSeverity, EventHandler_Type_e in_eType, uint32_t in_u32AdditionalData, uint8_t *inout_pu8ContextReport, uint32_t in_u32ContextDataSize);
+static EventHandler_FilterAction_e EventHandler_ClassifyEvent(const EventHandler_Context_s *in_psContext, Modules_Id_e in_eModuleId, uint32_t in_u32LocationInModule, EventHandler_Severity_e in_eSeverity, EventHandler_Type_e in_eType);
+static uint32_t EventHandler_GetFilterClassMask(uint32_t in_u32SeverityMask, uint32_t in_u32TypeMask);
+static void EventHandler_ComposeAndSendReport(EventHandler_Context_s *inout_psContext, float64_t in_f64CurrentTimeInSeconds, Modules_Id_e in_eModuleId, uint32_t in_u32LocationInModule, EventHandler_Severity_e in_eSeverity, EventHandler_Type_e in_eType, uint32_t in_u32AdditionalData, uint8_t *inout_pu8ContextReport, uint32_t in_u32ContextDataSize);
+static void EventHandler_ComposeReport(uint8_t *out_pu8EventData, float64_t in_f64CurrentTimeInSeconds, Modules_Id_e in_eModuleId, uint32_t in_u32LocationInModule, EventHandler_Severity_e in_eSeverity, EventHandler_Type_e in_eType, uint32_t in_u32AdditionalData, uint32_t in_u32SequenceNumber, uint32_t in_u32ContextDataSize);
+static void EventHandler_FlushBatchReports(EventHandler_Context_s *inout_psContext);
 static void EventHandler_Convert32BitNumberToByteArray(uint32_t in_u32Number, uint8_t **inout_pu8Data, const uint8_t * const in_pu8DataBoundary);
 
 
@@ -78,7 +234,7 @@ static void EventHandler_Convert32BitNumberToByteArray(uint32_t in_u32Number, ui
  */
 void EventHandler_GenerateEventReport(Modules_Id_e in_eModuleId, uint32_t in_u32LocationInModule, EventHandler_Severity_e in_eSeverity, EventHandler_Type_e in_eType)
 {
-    EventHandler_GenerateEventReportUserData(in_eModuleId, in_u32LocationInModule, in_eSeverity, in_eType, DUMMY_USER_DATA);
+    EventHandler_ContextGenerateEventReportUserData(&m_sDefaultContext, in_eModuleId, in_u32LocationInModule, in_eSeverity, in_eType, DUMMY_USER_DATA);
     return;
 }
 
@@ -95,188 +251,84 @@ void EventHandler_GenerateEventReport(Modules_Id_e in_eModuleId, uint32_t in_u32
  */
 void EventHandler_GenerateEventReportUserData(Modules_Id_e in_eModuleId, uint32_t in_u32LocationInModule, EventHandler_Severity_e in_eSeverity, EventHandler_Type_e in_eType, uint32_t in_u32AdditionalData)
 {
-    float64_t f64CurrentTimeInSeconds = TIMING_INITIAL_TIME;
-
-    f64CurrentTimeInSeconds = Timing_GetTime();
-
-    if (EVENTHANDLER_NUMBER_OF_EVENT_TYPES > in_eType)
-    {
-        if (EVENTHANDLER_NUMBER_OF_EVENT_SEVERITIES > in_eSeverity)
-        {
-            /* SRS-013 */
-            if (E_TRUE == m_abIsEnabledReporting[in_eType])
-            {
-                /* SRS-008 */
-                if ((E_EVENTHANDLER_TYPE_NULLARGUMENT == in_eType) && (E_EVENTHANDLER_SEVERITY_MEDIUM > in_eSeverity))
-                {
-                    in_eSeverity = E_EVENTHANDLER_SEVERITY_MEDIUM;
-                }
-
-                /* SRS-010 */
-                /* SRS-011 */
-                m_au32EventsCounter[in_eSeverity][in_eType]++;
-
-                if (E_EVENTHANDLER_SEVERITY_MEDIUM > in_eSeverity)
-                {
-                    if (E_TRUE == m_abIsStandbyMode[in_eType])
-                    {
-                        /* SRS-009 */
-                        if ((m_af64LastTime[in_eType] + m_f64ReenableReportingAfterSeconds) < f64CurrentTimeInSeconds)
-                        {
-                            /* SRS-012 */
-                            m_abIsStandbyMode[in_eType] = E_FALSE;
-                            m_af64LastTime[in_eType] = f64CurrentTimeInSeconds;
-                            EventHandler_ComposeAndSendReport(f64CurrentTimeInSeconds, in_eModuleId, in_u32LocationInModule, in_eSeverity, in_eType, in_u32AdditionalData);
-                        }
-                    }
-                    else
-                    {
-                        /* SRS-009 */
-                        if ((m_af64LastTime[in_eType] + OVERFLOW_LIMIT_IN_SECONDS) > f64CurrentTimeInSeconds)
-                        {
-                            /* SRS-011 */
-                            m_abIsStandbyMode[in_eType] = E_TRUE;
-                        }
-
-                        m_af64LastTime[in_eType] = f64CurrentTimeInSeconds;
-                        EventHandler_ComposeAndSendReport(f64CurrentTimeInSeconds, in_eModuleId, in_u32LocationInModule, in_eSeverity, in_eType, in_u32AdditionalData);
-                    }
-                }
-                else
-                {
-                    EventHandler_ComposeAndSendReport(f64CurrentTimeInSeconds, in_eModuleId, in_u32LocationInModule, in_eSeverity, in_eType, in_u32AdditionalData);
-
-                    /* SRS-004 */
-                    if (E_EVENTHANDLER_SEVERITY_MEDIUM == in_eSeverity)
-                    {
-                        EventHandler_InitializeBeforeReset();
-                        SystemReset_ResetSystem();
-                    }
-                }
-            }
-        }
-        else
-        {
-            /* Someone forgot to change (increment) the definition of EVENTHANDLER_NUMBER_OF_EVENT_SEVERITIES when adding some new enums */
-            EventHandler_ComposeAndSendReport(f64CurrentTimeInSeconds, m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_GENERATEEVENTREPORTUSERDATA_SEVERITIES, E_EVENTHANDLER_SEVERITY_NORMAL, E_EVENTHANDLER_TYPE_UNUPDATEDCONSTANTS, (uint32_t) in_eSeverity);
-        }
-    }
-    else
-    {
-        /* Someone forgot to change (increment) the definition of EVENTHANDLER_NUMBER_OF_EVENT_TYPES when adding some new enums */
-        EventHandler_ComposeAndSendReport(f64CurrentTimeInSeconds, m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_GENERATEEVENTREPORTUSERDATA_TYPES, E_EVENTHANDLER_SEVERITY_NORMAL, E_EVENTHANDLER_TYPE_UNUPDATEDCONSTANTS, (uint32_t) in_eType);
-    }
-
+    EventHandler_ContextGenerateEventReportUserData(&m_sDefaultContext, in_eModuleId, in_u32LocationInModule, in_eSeverity, in_eType, in_u32AdditionalData);
     return;
 }
 
 /**
- * @brief Composes the event report (data), sends it and stores it
+ * @brief Handles the event and creates a report followed by the context data
  *
- * @param in_f64CurrentTimeInSeconds Current time from system start in seconds
- * @param in_eModuleId               ID of a module, in which an event occurred
- * @param in_u32LocationInModule     Event instance - a specific and unique place in the module
- * @param in_eSeverity               Event severity
- * @param in_eType                   Event type
- * @param in_u32AdditionalData       User defined data up to 4B used for event context
+ * @param in_eModuleId              ID of a module, in which an event occurred
+ * @param in_u32LocationInModule    Event instance - a specific and unique place in the module
+ * @param in_eSeverity              Event severity
+ * @param in_eType                  Event type
+ * @param in_u32AdditionalData      User defined data up to 4B used for event context
+ * @param in_pu8ContextData         Context data array, e.g. the first bytes of failed data
+ * @param in_u32ContextDataSize     Size of context data in bytes, at most EVENTHANDLER_CONTEXT_DATA_MAX_SIZE_IN_BYTES
  */
-static void EventHandler_ComposeAndSendReport(float64_t in_f64CurrentTimeInSeconds, Modules_Id_e in_eModuleId, uint32_t in_u32LocationInModule, EventHandler_Severity_e in_eSeverity, EventHandler_Type_e in_eType, uint32_t in_u32AdditionalData)
+void EventHandler_GenerateEventReportContextData(Modules_Id_e in_eModuleId, uint32_t in_u32LocationInModule, EventHandler_Severity_e in_eSeverity, EventHandler_Type_e in_eType, uint32_t in_u32AdditionalData, const uint8_t *in_pu8ContextData, uint32_t in_u32ContextDataSize)
 {
-    ConversionFloatToByte_u uAuxiliaryConversion;
-    uint32_t u32IterBytes = COMMON_STARTING_INDEX_OF_ARRAY;
-    uint8_t au8EventData[EVENT_DATA_SIZE_IN_BYTES];
-    uint8_t *pu8EventData = au8EventData;
-    uint8_t *pu8EventDataBoundary = au8EventData + EVENT_DATA_SIZE_IN_BYTES;
-
-    uAuxiliaryConversion.f64Variable = in_f64CurrentTimeInSeconds;
-
-    if (pu8EventDataBoundary >= (pu8EventData + COMMON_FLOAT64_SIZE_IN_BYTES))
-    {
-        for (; COMMON_FLOAT64_SIZE_IN_BYTES > u32IterBytes; u32IterBytes++)
-        {
-            *pu8EventData = uAuxiliaryConversion.au8Buffer[u32IterBytes];
-            pu8EventData++;
-        }
-    }
-
-    EventHandler_Convert32BitNumberToByteArray((uint32_t) in_eModuleId, &pu8EventData, pu8EventDataBoundary);
-    EventHandler_Convert32BitNumberToByteArray(in_u32LocationInModule, &pu8EventData, pu8EventDataBoundary);
-    EventHandler_Convert32BitNumberToByteArray((uint32_t) in_eSeverity, &pu8EventData, pu8EventDataBoundary);
-    EventHandler_Convert32BitNumberToByteArray((uint32_t) in_eType, &pu8EventData, pu8EventDataBoundary);
-    EventHandler_Convert32BitNumberToByteArray(in_u32AdditionalData, &pu8EventData, pu8EventDataBoundary);
-
-    /* SRS-014 */
-    Comm_SendEventReport(au8EventData, EVENT_DATA_SIZE_IN_BYTES);
-
-    /* SRS-015 */
-    Storage_StoreEventReport(au8EventData, EVENT_DATA_SIZE_IN_BYTES);
-
+    EventHandler_ContextGenerateEventReportContextData(&m_sDefaultContext, in_eModuleId, in_u32LocationInModule, in_eSeverity, in_eType, in_u32AdditionalData, in_pu8ContextData, in_u32ContextDataSize);
     return;
 }
 
 /**
- * @brief Takes a 32-bit number, splits it into 4 1-Byte-long pieces and writes them into the provided array
+ * @brief Handles the events of the batch and sends their reports together
  *
- * @param in_u32Number       Number, which shall be converted
- * @param inout_ppu8Data     Pointer to the beginning pointer of the provided array
- * @param in_pu8DataBoundary Pointer, which stands right after the provided array
+ * @param in_psBatch    Events to be handled
  */
-static void EventHandler_Convert32BitNumberToByteArray(uint32_t in_u32Number, uint8_t **inout_ppu8Data, const uint8_t * const in_pu8DataBoundary)
+void EventHandler_GenerateEventReportBatch(const EventHandler_EventBatch_s *in_psBatch)
 {
-    uint8_t *pu8Data;
-
-    pu8Data = *inout_ppu8Data + COMMON_UINT32_SIZE_IN_BYTES;
-
-    if (in_pu8DataBoundary >= pu8Data)
-    {
-        while (pu8Data > *inout_ppu8Data)
-        {
-            pu8Data--;
-            *pu8Data = (uint8_t) (in_u32Number & EXTRACT_ONE_BYTE);
-            in_u32Number >>= COMMON_BYTE_SIZE_IN_BITS;
-        }
-
-        *inout_ppu8Data += COMMON_UINT32_SIZE_IN_BYTES;
-    }
-
+    EventHandler_ContextGenerateEventReportBatch(&m_sDefaultContext, in_psBatch);
     return;
 }
 
 /**
- * @brief Initializes all static arrays to correct values
+ * @brief Initializes the default context, which sends and stores the reports, and recovers the event log
  */
 void EventHandler_InitializeOnStart(void)
 {
-    uint32_t u32IterType = COMMON_STARTING_INDEX_OF_ARRAY;
-    uint32_t u32IterSeverity = COMMON_STARTING_INDEX_OF_ARRAY;
+#if defined(EVENTHANDLER_USE_SINK_WORKERS)
+    /* A slow storage must not delay the downlink, the newest reports are worth more to it */
+    static const SinkWorker_OverflowPolicy_e aeOverflowPolicies[DEFAULT_CONTEXT_NUMBER_OF_SINKS] =
+    {
+        E_SINKWORKER_OVERFLOW_DROPOLDEST,
+        E_SINKWORKER_OVERFLOW_DROPNEWEST
+    };
+    EventHandler_Sink_f apfWorkerSinks[DEFAULT_CONTEXT_NUMBER_OF_SINKS];
+#endif
 
-    EventHandler_InitializeBeforeReset();
+    m_sDefaultContext.bIsUsed = E_TRUE;
+    m_sDefaultContext.bIsEnabledReset = E_TRUE;
 
-    for (u32IterType = COMMON_STARTING_INDEX_OF_ARRAY; EVENTHANDLER_NUMBER_OF_EVENT_TYPES > u32IterType; u32IterType++)
-    {
-        for (u32IterSeverity = COMMON_STARTING_INDEX_OF_ARRAY; EVENTHANDLER_NUMBER_OF_EVENT_SEVERITIES > u32IterSeverity; u32IterSeverity++)
-        {
-            m_au32EventsCounter[u32IterSeverity][u32IterType] = UNINITIALIZED_COUNTER;
-        }
+#if defined(EVENTHANDLER_USE_SINK_WORKERS)
+    /* SRS-014 */
+    apfWorkerSinks[COMMON_STARTING_INDEX_OF_ARRAY] = Comm_SendEventReport;
 
-        m_abIsEnabledReporting[u32IterType] = E_TRUE;
-    }
+    /* SRS-015 */
+    apfWorkerSinks[COMMON_STARTING_INDEX_OF_ARRAY + 1U] = Storage_StoreEventReport;
 
-    return;
-}
+    SinkWorker_Start(apfWorkerSinks, aeOverflowPolicies, DEFAULT_CONTEXT_NUMBER_OF_SINKS);
+    m_sDefaultContext.apfSinks[COMMON_STARTING_INDEX_OF_ARRAY] = SinkWorker_SubmitReport;
+    m_sDefaultContext.u32NumberOfSinks = 1U;
+#else
+    /* SRS-014 */
+    m_sDefaultContext.apfSinks[COMMON_STARTING_INDEX_OF_ARRAY] = Comm_SendEventReport;
 
-/**
- * @brief Initializes the static arrays, which would block events processing otherwise
- */
-static void EventHandler_InitializeBeforeReset(void)
-{
-    uint32_t u32IterType = COMMON_STARTING_INDEX_OF_ARRAY;
+    /* SRS-015 */
+    m_sDefaultContext.apfSinks[COMMON_STARTING_INDEX_OF_ARRAY + 1U] = Storage_StoreEventReport;
 
-    for (u32IterType = COMMON_STARTING_INDEX_OF_ARRAY; EVENTHANDLER_NUMBER_OF_EVENT_TYPES > u32IterType; u32IterType++)
-    {
-        m_af64LastTime[u32IterType] = TIMING_INITIAL_TIME;
-        m_abIsStandbyMode[u32IterType] = E_FALSE;
-    }
+    m_sDefaultContext.u32NumberOfSinks = DEFAULT_CONTEXT_NUMBER_OF_SINKS;
+#endif
+    EventHandler_ContextInitializeOnStart(&m_sDefaultContext);
+
+    /* The events raised during the recovery of the event log wait until the numbering is known */
+    EventHandler_BeginProcessing(&m_sDefaultContext);
+    Storage_Initialize();
+
+    /* The numbering continues after the newest stored report, so the receiver sees no restart */
+    m_sDefaultContext.u32NextSequenceNumber = Storage_GetNextSequenceNumber();
+    EventHandler_ProcessDeferredEvents(&m_sDefaultContext);
 
     return;
 }
@@ -291,27 +343,7 @@ static void EventHandler_InitializeBeforeReset(void)
  */
 uint32_t EventHandler_GetEventsCounter(EventHandler_Severity_e in_eSeverity, EventHandler_Type_e in_eType)
 {
-    uint32_t u32EventsCounter = UNINITIALIZED_COUNTER;
-
-    if (EVENTHANDLER_NUMBER_OF_EVENT_SEVERITIES > in_eSeverity)
-    {
-        if (EVENTHANDLER_NUMBER_OF_EVENT_TYPES > in_eType)
-        {
-            u32EventsCounter = m_au32EventsCounter[in_eSeverity][in_eType];
-        }
-        else
-        {
-            /* Someone may have forgotten to change (increment) the definition of EVENTHANDLER_NUMBER_OF_EVENT_TYPES when adding some new enums */
-            EventHandler_GenerateEventReportUserData(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_GETEVENTSCOUNTER_TYPES, E_EVENTHANDLER_SEVERITY_NORMAL, E_EVENTHANDLER_TYPE_UNUPDATEDCONSTANTS, (uint32_t) in_eType);
-        }
-    }
-    else
-    {
-        /* Someone may have forgotten to change (increment) the definition of EVENTHANDLER_NUMBER_OF_EVENT_SEVERITIES when adding some new enums */
-        EventHandler_GenerateEventReportUserData(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_GETEVENTSCOUNTER_SEVERITIES, E_EVENTHANDLER_SEVERITY_NORMAL, E_EVENTHANDLER_TYPE_UNUPDATEDCONSTANTS, (uint32_t) in_eSeverity);
-    }
-
-    return u32EventsCounter;
+    return EventHandler_ContextGetEventsCounter(&m_sDefaultContext, in_eSeverity, in_eType);
 }
 
 /**
@@ -324,19 +356,7 @@ uint32_t EventHandler_GetEventsCounter(EventHandler_Severity_e in_eSeverity, Eve
  */
 boolean EventHandler_GetStandbyMode(EventHandler_Type_e in_eType)
 {
-    boolean bIsStandbyMode = E_FALSE;
-
-    if (EVENTHANDLER_NUMBER_OF_EVENT_TYPES > in_eType)
-    {
-        bIsStandbyMode = m_abIsStandbyMode[in_eType];
-    }
-    else
-    {
-        /* Someone may have forgotten to change (increment) the definition of EVENTHANDLER_NUMBER_OF_EVENT_TYPES when adding some new enums */
-        EventHandler_GenerateEventReportUserData(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_GETSTANDBYMODE_TYPES, E_EVENTHANDLER_SEVERITY_NORMAL, E_EVENTHANDLER_TYPE_UNUPDATEDCONSTANTS, (uint32_t) in_eType);
-    }
-
-    return bIsStandbyMode;
+    return EventHandler_ContextGetStandbyMode(&m_sDefaultContext, in_eType);
 }
 
 /**
@@ -349,19 +369,7 @@ boolean EventHandler_GetStandbyMode(EventHandler_Type_e in_eType)
  */
 boolean EventHandler_GetEnabledReporting(EventHandler_Type_e in_eType)
 {
-    boolean bIsEnabledReporting = E_FALSE;
-
-    if (EVENTHANDLER_NUMBER_OF_EVENT_TYPES > in_eType)
-    {
-        bIsEnabledReporting = m_abIsEnabledReporting[in_eType];
-    }
-    else
-    {
-        /* Someone may have forgotten to change (increment) the definition of EVENTHANDLER_NUMBER_OF_EVENT_TYPES when adding some new enums */
-        EventHandler_GenerateEventReportUserData(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_GETENABLEDREPORTING_TYPES, E_EVENTHANDLER_SEVERITY_NORMAL, E_EVENTHANDLER_TYPE_UNUPDATEDCONSTANTS, (uint32_t) in_eType);
-    }
-
-    return bIsEnabledReporting;
+    return EventHandler_ContextGetEnabledReporting(&m_sDefaultContext, in_eType);
 }
 
 /* SRS-013 */
@@ -373,15 +381,1738 @@ boolean EventHandler_GetEnabledReporting(EventHandler_Type_e in_eType)
  */
 void EventHandler_SetEnabledReporting(EventHandler_Type_e in_eType, boolean in_bIsEnabled)
 {
-    if (EVENTHANDLER_NUMBER_OF_EVENT_TYPES > in_eType)
+    EventHandler_ContextSetEnabledReporting(&m_sDefaultContext, in_eType, in_bIsEnabled);
+    return;
+}
+
+/**
+ * @brief Gets the number of events, which were generated during processing of another event and dropped,
+ *        because the nesting was too deep or the queue of deferred events was full
+ *
+ * @return   Number of the dropped nested events
+ */
+uint32_t EventHandler_GetDroppedNestedEventsCounter(void)
+{
+    return EventHandler_ContextGetDroppedNestedEventsCounter(&m_sDefaultContext);
+}
+
+/**
+ * @brief Gets the number of events reported without their context data, because the arena was full
+ *
+ * @return   Number of the dropped context data
+ */
+uint32_t EventHandler_GetDroppedContextDataCounter(void)
+{
+    return EventHandler_ContextGetDroppedContextDataCounter(&m_sDefaultContext);
+}
+
+/**
+ * @brief Gets the sequence number, which the next report will carry
+ *
+ * @return   Sequence number of the next report
+ */
+uint32_t EventHandler_GetNextSequenceNumber(void)
+{
+    return EventHandler_ContextGetNextSequenceNumber(&m_sDefaultContext);
+}
+
+/**
+ * @brief Gets the rate of the events of the specified event severity and type within the rolling window
+ *
+ * @param in_eSeverity   Defined event severity
+ * @param in_eType       Defined event type
+ * @param in_eWindow     Defined rolling window
+ *
+ * @return               Events per minute averaged over the window
+ */
+float64_t EventHandler_GetEventsRate(EventHandler_Severity_e in_eSeverity, EventHandler_Type_e in_eType, EventHandler_RateWindow_e in_eWindow)
+{
+    return EventHandler_ContextGetEventsRate(&m_sDefaultContext, in_eSeverity, in_eType, in_eWindow);
+}
+
+/**
+ * @brief Gets the event sources (module, location) generating most of the events, ordered from the noisiest one
+ *
+ * @param out_psHeavyHitters              Array for the heavy hitters
+ * @param in_u32MaxNumberOfHeavyHitters   Size of the array
+ *
+ * @return                                Number of the heavy hitters written into the array
+ */
+uint32_t EventHandler_GetHeavyHitters(EventHitters_HeavyHitter_s *out_psHeavyHitters, uint32_t in_u32MaxNumberOfHeavyHitters)
+{
+    return EventHandler_ContextGetHeavyHitters(&m_sDefaultContext, out_psHeavyHitters, in_u32MaxNumberOfHeavyHitters);
+}
+
+/**
+ * @brief Appends a filter rule, it takes effect after EventHandler_CompileFilterRules, later rules override earlier ones
+ *
+ * @param in_psRule   Filter rule to be added
+ *
+ * @return E_FALSE    The rule is invalid or there is no room left for it
+ * @return E_TRUE     The rule has been added
+ */
+boolean EventHandler_AddFilterRule(const EventHandler_FilterRule_s *in_psRule)
+{
+    return EventHandler_ContextAddFilterRule(&m_sDefaultContext, in_psRule);
+}
+
+/**
+ * @brief Removes all filter rules and lets all events pass
+ */
+void EventHandler_ClearFilterRules(void)
+{
+    EventHandler_ContextClearFilterRules(&m_sDefaultContext);
+    return;
+}
+
+/**
+ * @brief Compiles the added filter rules into the lookup tables used for every event
+ */
+void EventHandler_CompileFilterRules(void)
+{
+    EventHandler_ContextCompileFilterRules(&m_sDefaultContext);
+    return;
+}
+
+/**
+ * @brief Reads a 32-bit field of an event report (or of other data with the same layout), the most significant byte first
+ *
+ * @param in_pu8Data   Source array of at least 4 bytes
+ *
+ * @return             Read number
+ */
+uint32_t EventHandler_ReadWord(const uint8_t *in_pu8Data)
+{
+    uint32_t u32Word = 0U;
+    uint32_t u32IterBytes = COMMON_STARTING_INDEX_OF_ARRAY;
+
+    for (; COMMON_UINT32_SIZE_IN_BYTES > u32IterBytes; u32IterBytes++)
     {
-        m_abIsEnabledReporting[in_eType] = in_bIsEnabled;
+        u32Word = (u32Word << COMMON_BYTE_SIZE_IN_BITS) | in_pu8Data[u32IterBytes];
     }
-    else
+
+    return u32Word;
+}
+
+/**
+ * @brief Gives the size of the event report together with the context data it declares
+ *
+ * @param in_pu8Report   Report of at least EVENTHANDLER_REPORT_SIZE_IN_BYTES
+ *
+ * @return               Size of the report in bytes, EVENTHANDLER_INVALID_REPORT_SIZE if its context data are too long
+ */
+uint32_t EventHandler_GetReportSize(const uint8_t *in_pu8Report)
+{
+    uint32_t u32ReportSize = EVENTHANDLER_INVALID_REPORT_SIZE;
+    uint32_t u32ContextDataSize = EventHandler_ReadWord(&in_pu8Report[EVENTHANDLER_REPORT_CONTEXT_SIZE_OFFSET]);
+
+    if (EVENTHANDLER_CONTEXT_DATA_MAX_SIZE_IN_BYTES >= u32ContextDataSize)
     {
-        /* Someone may have forgotten to change (increment) the definition of EVENTHANDLER_NUMBER_OF_EVENT_TYPES when adding some new enums */
-        EventHandler_GenerateEventReportUserData(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_SETENABLEDREPORTING_TYPES, E_EVENTHANDLER_SEVERITY_NORMAL, E_EVENTHANDLER_TYPE_UNUPDATEDCONSTANTS, (uint32_t) in_eType);
+        u32ReportSize = EVENTHANDLER_REPORT_SIZE_IN_BYTES + u32ContextDataSize;
     }
 
-    return;
+    return u32ReportSize;
+}
+
+/**
+ * @brief Gives the default context, which the functions without a context work with
+ *
+ * @return   Default context
+ */
+EventHandler_Context_s *EventHandler_GetDefaultContext(void)
+{
+    return &m_sDefaultContext;
+}
+
+/**
+ * @brief Takes an unused context from the pool and initializes it, contexts cannot be released
+ *
+ * Every context shall be used by one thread of execution only, the creation itself is meant for the system start.
+ *
+ * @param in_ppfSinks            Array of the sinks receiving the composed reports of the context
+ * @param in_u32NumberOfSinks    Number of the sinks, at most EVENTHANDLER_MAX_NUMBER_OF_SINKS
+ *
+ * @return                       New context, NULL if the sinks are invalid or the pool is exhausted
+ */
+EventHandler_Context_s *EventHandler_CreateContext(const EventHandler_Sink_f *in_ppfSinks, uint32_t in_u32NumberOfSinks)
+{
+    EventHandler_Context_s *psContext = NULL;
+    uint32_t u32IterContext = COMMON_STARTING_INDEX_OF_ARRAY;
+    uint32_t u32IterSink = COMMON_STARTING_INDEX_OF_ARRAY;
+
+    if ((EVENTHANDLER_MAX_NUMBER_OF_SINKS < in_u32NumberOfSinks) || ((NULL == in_ppfSinks) && (0U != in_u32NumberOfSinks)))
+    {
+        EventHandler_GenerateEventReportUserData(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_CREATECONTEXT_SINKS, E_EVENTHANDLER_SEVERITY_NORMAL, E_EVENTHANDLER_TYPE_ADDRESSRANGE, in_u32NumberOfSinks);
+        return NULL;
+    }
+
+    for (; (EVENTHANDLER_MAX_NUMBER_OF_CONTEXTS > u32IterContext) && (NULL == psContext); u32IterContext++)
+    {
+        if (E_FALSE == m_asContextsPool[u32IterContext].bIsUsed)
+        {
+            psContext = &m_asContextsPool[u32IterContext];
+        }
+    }
+
+    if (NULL == psContext)
+    {
+        EventHandler_GenerateEventReportUserData(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_CREATECONTEXT_FULL, E_EVENTHANDLER_SEVERITY_LOW, E_EVENTHANDLER_TYPE_ADDRESSRANGE, EVENTHANDLER_MAX_NUMBER_OF_CONTEXTS);
+    }
+    else
+    {
+        psContext->bIsUsed = E_TRUE;
+
+        for (; in_u32NumberOfSinks > u32IterSink; u32IterSink++)
+        {
+            psContext->apfSinks[u32IterSink] = in_ppfSinks[u32IterSink];
+        }
+
+        psContext->u32NumberOfSinks = in_u32NumberOfSinks;
+        psContext->bIsEnabledReset = E_TRUE;
+        psContext->pfTimeSource = NULL;
+        EventHandler_ContextInitializeOnStart(psContext);
+    }
+
+    return psContext;
+}
+
+/**
+ * @brief Initializes all arrays of the context to correct values, the sinks, the reset policy and the time source are kept
+ *
+ * @param inout_psContext   Context of the event reporter
+ */
+void EventHandler_ContextInitializeOnStart(EventHandler_Context_s *inout_psContext)
+{
+    uint32_t u32IterType = COMMON_STARTING_INDEX_OF_ARRAY;
+    uint32_t u32IterSeverity = COMMON_STARTING_INDEX_OF_ARRAY;
+
+    if (NULL == inout_psContext)
+    {
+        EventHandler_GenerateEventReport(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_CONTEXTINITIALIZEONSTART_NULL, E_EVENTHANDLER_SEVERITY_MEDIUM, E_EVENTHANDLER_TYPE_NULLARGUMENT);
+        return;
+    }
+
+#if defined(EVENTHANDLER_USE_SINK_WORKERS)
+    if (E_FALSE == inout_psContext->bAreLocksInitialized)
+    {
+        (void) pthread_mutex_init(&inout_psContext->sProcessingLock, NULL);
+        (void) pthread_mutex_init(&inout_psContext->sQueueLock, NULL);
+        inout_psContext->bAreLocksInitialized = E_TRUE;
+    }
+
+    inout_psContext->sSinkEvents.u32Head = COMMON_STARTING_INDEX_OF_ARRAY;
+    inout_psContext->sSinkEvents.u32NumberOfEvents = UNINITIALIZED_COUNTER;
+#endif
+
+    EventHandler_InitializeBeforeReset(inout_psContext);
+
+    for (u32IterType = COMMON_STARTING_INDEX_OF_ARRAY; EVENTHANDLER_NUMBER_OF_EVENT_TYPES > u32IterType; u32IterType++)
+    {
+        for (u32IterSeverity = COMMON_STARTING_INDEX_OF_ARRAY; EVENTHANDLER_NUMBER_OF_EVENT_SEVERITIES > u32IterSeverity; u32IterSeverity++)
+        {
+            inout_psContext->au32EventsCounter[u32IterSeverity][u32IterType] = UNINITIALIZED_COUNTER;
+        }
+
+        inout_psContext->abIsEnabledReporting[u32IterType] = E_TRUE;
+    }
+
+    EventStatistics_Initialize(&inout_psContext->sStatistics);
+    EventHitters_Initialize(&inout_psContext->sHitters);
+
+    inout_psContext->u32NestingDepth = NESTING_DEPTH_IDLE;
+    inout_psContext->sDeferredEvents.u32Head = COMMON_STARTING_INDEX_OF_ARRAY;
+    inout_psContext->sDeferredEvents.u32NumberOfEvents = UNINITIALIZED_COUNTER;
+    inout_psContext->u32DroppedNestedEventsCounter = UNINITIALIZED_COUNTER;
+    inout_psContext->u32DeferredBatchEventsSize = UNINITIALIZED_COUNTER;
+    inout_psContext->bIsBatching = E_FALSE;
+    inout_psContext->u32BatchReportsSize = UNINITIALIZED_COUNTER;
+    inout_psContext->u32NextSequenceNumber = UNINITIALIZED_COUNTER;
+    inout_psContext->u32ContextArenaSize = UNINITIALIZED_COUNTER;
+    inout_psContext->u32DroppedContextDataCounter = UNINITIALIZED_COUNTER;
+    inout_psContext->u32SuppressedResetsCounter = UNINITIALIZED_COUNTER;
+
+    EventHandler_ContextClearFilterRules(inout_psContext);
+
+    return;
+}
+
+/**
+ * @brief Initializes the arrays of the context, which would block events processing otherwise
+ *
+ * @param inout_psContext   Context of the event reporter
+ */
+static void EventHandler_InitializeBeforeReset(EventHandler_Context_s *inout_psContext)
+{
+    uint32_t u32IterType = COMMON_STARTING_INDEX_OF_ARRAY;
+
+    for (u32IterType = COMMON_STARTING_INDEX_OF_ARRAY; EVENTHANDLER_NUMBER_OF_EVENT_TYPES > u32IterType; u32IterType++)
+    {
+        inout_psContext->af64LastTime[u32IterType] = TIMING_INITIAL_TIME;
+        inout_psContext->abIsStandbyMode[u32IterType] = E_FALSE;
+    }
+
+    return;
+}
+
+/**
+ * @brief Gives the current time of the context
+ *
+ * @param in_psContext   Context of the event reporter
+ *
+ * @return               Time in seconds
+ */
+static float64_t EventHandler_GetTime(const EventHandler_Context_s *in_psContext)
+{
+    return (NULL != in_psContext->pfTimeSource) ? in_psContext->pfTimeSource() : Timing_GetTime();
+}
+
+/* SRS-005 */
+/**
+ * @brief Handles the event and creates a report in the specified context
+ *
+ * @param inout_psContext           Context of the event reporter
+ * @param in_eModuleId              ID of a module, in which an event occurred
+ * @param in_u32LocationInModule    Event instance - a specific and unique place in the module
+ * @param in_eSeverity              Event severity
+ * @param in_eType                  Event type
+ */
+void EventHandler_ContextGenerateEventReport(EventHandler_Context_s *inout_psContext, Modules_Id_e in_eModuleId, uint32_t in_u32LocationInModule, EventHandler_Severity_e in_eSeverity, EventHandler_Type_e in_eType)
+{
+    EventHandler_ContextGenerateEventReportUserData(inout_psContext, in_eModuleId, in_u32LocationInModule, in_eSeverity, in_eType, DUMMY_USER_DATA);
+    return;
+}
+
+/* SRS-005 */
+/* SRS-006 */
+/**
+ * @brief Handles the event and creates a report in the specified context
+ *
+ * Events generated while another event is being processed (e.g. by a failing sink) are deferred
+ * and processed after it, so the stack depth and the number of reports per call stay bounded.
+ * With EVENTHANDLER_USE_SINK_WORKERS, a thread waits while another one processes the events of the
+ * context; the events of the sink threads are queued for the processing thread instead.
+ *
+ * @param inout_psContext           Context of the event reporter
+ * @param in_eModuleId              ID of a module, in which an event occurred
+ * @param in_u32LocationInModule    Event instance - a specific and unique place in the module
+ * @param in_eSeverity              Event severity
+ * @param in_eType                  Event type
+ * @param in_u32AdditionalData      User defined data up to 4B used for event context
+ */
+void EventHandler_ContextGenerateEventReportUserData(EventHandler_Context_s *inout_psContext, Modules_Id_e in_eModuleId, uint32_t in_u32LocationInModule, EventHandler_Severity_e in_eSeverity, EventHandler_Type_e in_eType, uint32_t in_u32AdditionalData)
+{
+    if (NULL == inout_psContext)
+    {
+        EventHandler_GenerateEventReport(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_CONTEXTGENERATEEVENTREPORTUSERDATA_NULL, E_EVENTHANDLER_SEVERITY_MEDIUM, E_EVENTHANDLER_TYPE_NULLARGUMENT);
+        return;
+    }
+
+    EventHandler_LockQueue(inout_psContext);
+
+    if (E_TRUE == EventHandler_IsEventDeferred(inout_psContext))
+    {
+        EventHandler_DeferEvent(inout_psContext, in_eModuleId, in_u32LocationInModule, in_eSeverity, in_eType, in_u32AdditionalData, NULL, 0U);
+        EventHandler_UnlockQueue(inout_psContext);
+    }
+    else
+    {
+        EventHandler_UnlockQueue(inout_psContext);
+        EventHandler_BeginProcessing(inout_psContext);
+        EventHandler_ProcessEvent(inout_psContext, in_eModuleId, in_u32LocationInModule, in_eSeverity, in_eType, in_u32AdditionalData, NULL, 0U);
+        EventHandler_ProcessDeferredEvents(inout_psContext);
+    }
+
+    return;
+}
+
+/**
+ * @brief Handles the event and creates a report followed by the context data in the specified context
+ *
+ * The context data are copied once into the arena of the context and referenced from there
+ * by the queue of deferred events and by the report handed over to the sinks. The arena is
+ * released when the context gets idle; an event not fitting into it is reported without its context data.
+ *
+ * @param inout_psContext           Context of the event reporter
+ * @param in_eModuleId              ID of a module, in which an event occurred
+ * @param in_u32LocationInModule    Event instance - a specific and unique place in the module
+ * @param in_eSeverity              Event severity
+ * @param in_eType                  Event type
+ * @param in_u32AdditionalData      User defined data up to 4B used for event context
+ * @param in_pu8ContextData         Context data array, e.g. the first bytes of failed data
+ * @param in_u32ContextDataSize     Size of context data in bytes, at most EVENTHANDLER_CONTEXT_DATA_MAX_SIZE_IN_BYTES
+ */
+void EventHandler_ContextGenerateEventReportContextData(EventHandler_Context_s *inout_psContext, Modules_Id_e in_eModuleId, uint32_t in_u32LocationInModule, EventHandler_Severity_e in_eSeverity, EventHandler_Type_e in_eType, uint32_t in_u32AdditionalData, const uint8_t *in_pu8ContextData, uint32_t in_u32ContextDataSize)
+{
+    uint8_t *pu8ContextReport = NULL;
+
+    if (NULL == inout_psContext)
+    {
+        EventHandler_GenerateEventReport(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_CONTEXTGENERATEEVENTREPORTCONTEXTDATA_NULL, E_EVENTHANDLER_SEVERITY_MEDIUM, E_EVENTHANDLER_TYPE_NULLARGUMENT);
+        return;
+    }
+
+    if ((NULL == in_pu8ContextData) && (0U != in_u32ContextDataSize))
+    {
+        EventHandler_ContextGenerateEventReport(inout_psContext, m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_CONTEXTGENERATEEVENTREPORTCONTEXTDATA_DATA, E_EVENTHANDLER_SEVERITY_MEDIUM, E_EVENTHANDLER_TYPE_NULLARGUMENT);
+        return;
+    }
+
+    if (EVENTHANDLER_CONTEXT_DATA_MAX_SIZE_IN_BYTES < in_u32ContextDataSize)
+    {
+        EventHandler_ContextGenerateEventReportUserData(inout_psContext, m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_CONTEXTGENERATEEVENTREPORTCONTEXTDATA_SIZE, E_EVENTHANDLER_SEVERITY_NORMAL, E_EVENTHANDLER_TYPE_ADDRESSRANGE, in_u32ContextDataSize);
+        return;
+    }
+
+    EventHandler_LockQueue(inout_psContext);
+
+    if (E_TRUE == EventHandler_IsEventDeferred(inout_psContext))
+    {
+        pu8ContextReport = EventHandler_ReserveContextReport(inout_psContext, in_pu8ContextData, &in_u32ContextDataSize);
+        EventHandler_DeferEvent(inout_psContext, in_eModuleId, in_u32LocationInModule, in_eSeverity, in_eType, in_u32AdditionalData, pu8ContextReport, in_u32ContextDataSize);
+        EventHandler_UnlockQueue(inout_psContext);
+    }
+    else
+    {
+        EventHandler_UnlockQueue(inout_psContext);
+        EventHandler_BeginProcessing(inout_psContext);
+
+        /* Reserved only now, the thread processing before may have released the arena meanwhile */
+        EventHandler_LockQueue(inout_psContext);
+        pu8ContextReport = EventHandler_ReserveContextReport(inout_psContext, in_pu8ContextData, &in_u32ContextDataSize);
+        EventHandler_UnlockQueue(inout_psContext);
+
+        EventHandler_ProcessEvent(inout_psContext, in_eModuleId, in_u32LocationInModule, in_eSeverity, in_eType, in_u32AdditionalData, pu8ContextReport, in_u32ContextDataSize);
+        EventHandler_ProcessDeferredEvents(inout_psContext);
+    }
+
+    return;
+}
+
+/**
+ * @brief Handles the events of the batch in the specified context and sends their reports together
+ *
+ * The time is read once for the whole batch and every sink gets the reports of up to
+ * EVENTHANDLER_BATCH_MAX_NUMBER_OF_EVENTS events in one call. A batch generated while another
+ * event is being processed is deferred as one entry, its events copied aside until the context
+ * gets idle; those not fitting are counted as dropped nested events.
+ *
+ * @param inout_psContext   Context of the event reporter
+ * @param in_psBatch        Events to be handled
+ */
+void EventHandler_ContextGenerateEventReportBatch(EventHandler_Context_s *inout_psContext, const EventHandler_EventBatch_s *in_psBatch)
+{
+    if (NULL == inout_psContext)
+    {
+        EventHandler_GenerateEventReport(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_CONTEXTGENERATEEVENTREPORTBATCH_NULL, E_EVENTHANDLER_SEVERITY_MEDIUM, E_EVENTHANDLER_TYPE_NULLARGUMENT);
+        return;
+    }
+
+    if ((NULL == in_psBatch) || (NULL == in_psBatch->peModuleIds) || (NULL == in_psBatch->pu32LocationsInModule) || (NULL == in_psBatch->peSeverities) || (NULL == in_psBatch->peTypes))
+    {
+        EventHandler_ContextGenerateEventReport(inout_psContext, m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_CONTEXTGENERATEEVENTREPORTBATCH_ARRAYS, E_EVENTHANDLER_SEVERITY_MEDIUM, E_EVENTHANDLER_TYPE_NULLARGUMENT);
+        return;
+    }
+
+    EventHandler_LockQueue(inout_psContext);
+
+    if (E_TRUE == EventHandler_IsEventDeferred(inout_psContext))
+    {
+        EventHandler_DeferBatch(inout_psContext, in_psBatch);
+        EventHandler_UnlockQueue(inout_psContext);
+    }
+    else
+    {
+        EventHandler_UnlockQueue(inout_psContext);
+        EventHandler_BeginProcessing(inout_psContext);
+        EventHandler_ProcessBatchInChunks(inout_psContext, in_psBatch);
+        EventHandler_ProcessDeferredEvents(inout_psContext);
+    }
+
+    return;
+}
+
+/**
+ * @brief Guards the nesting depth, the deferred events and the arena of the context against the other threads
+ *
+ * @param inout_psContext   Context of the event reporter
+ */
+static void EventHandler_LockQueue(EventHandler_Context_s *inout_psContext)
+{
+#if defined(EVENTHANDLER_USE_SINK_WORKERS)
+    if (E_TRUE == inout_psContext->bAreLocksInitialized)
+    {
+        (void) pthread_mutex_lock(&inout_psContext->sQueueLock);
+    }
+#else
+    (void) inout_psContext;
+#endif
+
+    return;
+}
+
+/**
+ * @brief Releases the guard taken by EventHandler_LockQueue
+ *
+ * @param inout_psContext   Context of the event reporter
+ */
+static void EventHandler_UnlockQueue(EventHandler_Context_s *inout_psContext)
+{
+#if defined(EVENTHANDLER_USE_SINK_WORKERS)
+    if (E_TRUE == inout_psContext->bAreLocksInitialized)
+    {
+        (void) pthread_mutex_unlock(&inout_psContext->sQueueLock);
+    }
+#else
+    (void) inout_psContext;
+#endif
+
+    return;
+}
+
+/**
+ * @brief Reserves the space for a report followed by the context data in the arena of the context and copies the context data there
+ *
+ * @param inout_psContext             Context of the event reporter
+ * @param in_pu8ContextData           Context data array
+ * @param inout_pu32ContextDataSize   Size of context data in bytes, set to 0 if the arena is full
+ *
+ * @return                            Space for the report followed by the context data, NULL if the arena is full
+ */
+static uint8_t *EventHandler_ReserveContextReport(EventHandler_Context_s *inout_psContext, const uint8_t *in_pu8ContextData, uint32_t *inout_pu32ContextDataSize)
+{
+    uint8_t *pu8ContextReport = NULL;
+    uint32_t u32IterBytes = COMMON_STARTING_INDEX_OF_ARRAY;
+
+    if ((inout_psContext->u32ContextArenaSize + EVENT_DATA_SIZE_IN_BYTES + *inout_pu32ContextDataSize) > EVENTHANDLER_CONTEXT_ARENA_SIZE_IN_BYTES)
+    {
+        inout_psContext->u32DroppedContextDataCounter++;
+        *inout_pu32ContextDataSize = 0U;
+    }
+    else
+    {
+        pu8ContextReport = &inout_psContext->au8ContextArena[inout_psContext->u32ContextArenaSize];
+        inout_psContext->u32ContextArenaSize += EVENT_DATA_SIZE_IN_BYTES + *inout_pu32ContextDataSize;
+
+        for (; *inout_pu32ContextDataSize > u32IterBytes; u32IterBytes++)
+        {
+            pu8ContextReport[EVENT_DATA_SIZE_IN_BYTES + u32IterBytes] = in_pu8ContextData[u32IterBytes];
+        }
+    }
+
+    return pu8ContextReport;
+}
+
+/**
+ * @brief Tells whether an event generated now has to wait in a queue, as the calling thread is processing an event
+ *        of the context already or it is a sink thread, which must not process events
+ *
+ * @param in_psContext   Context of the event reporter, its queue guarded
+ *
+ * @return E_FALSE       The calling thread processes the event, after the thread processing now if there is one
+ * @return E_TRUE        The event has to be deferred
+ */
+static boolean EventHandler_IsEventDeferred(const EventHandler_Context_s *in_psContext)
+{
+    boolean bIsDeferred = (NESTING_DEPTH_IDLE != in_psContext->u32NestingDepth) ? E_TRUE : E_FALSE;
+
+#if defined(EVENTHANDLER_USE_SINK_WORKERS)
+    if (E_TRUE == SinkWorker_IsWorkerThread())
+    {
+        bIsDeferred = E_TRUE;
+    }
+    else if ((E_TRUE == bIsDeferred) && (0 == pthread_equal(in_psContext->sProcessingThread, pthread_self())))
+    {
+        /* Another thread is processing, it is waited for in EventHandler_BeginProcessing */
+        bIsDeferred = E_FALSE;
+    }
+    else
+    {
+        ;
+    }
+#endif
+
+    return bIsDeferred;
+}
+
+/**
+ * @brief Makes the calling thread the one processing the events of the context, waits while another thread does,
+ *        EventHandler_ProcessDeferredEvents ends the processing
+ *
+ * @param inout_psContext   Context of the event reporter
+ */
+static void EventHandler_BeginProcessing(EventHandler_Context_s *inout_psContext)
+{
+#if defined(EVENTHANDLER_USE_SINK_WORKERS)
+    if (E_TRUE == inout_psContext->bAreLocksInitialized)
+    {
+        (void) pthread_mutex_lock(&inout_psContext->sProcessingLock);
+    }
+#endif
+
+    EventHandler_LockQueue(inout_psContext);
+    inout_psContext->u32NestingDepth = NESTING_DEPTH_OUTER;
+#if defined(EVENTHANDLER_USE_SINK_WORKERS)
+    inout_psContext->sProcessingThread = pthread_self();
+#endif
+    EventHandler_UnlockQueue(inout_psContext);
+
+    return;
+}
+
+/**
+ * @brief Takes the next free entry of the queue the calling thread defers to, counts the events
+ *        as dropped if the nesting is too deep or the queue is full
+ *
+ * @param inout_psContext        Context of the event reporter, its queue guarded
+ * @param in_u32NumberOfEvents   Number of the events the entry stands for
+ *
+ * @return                       Entry with its nesting depth set, NULL if there is none
+ */
+static DeferredEvent_s *EventHandler_AddDeferredEvent(EventHandler_Context_s *inout_psContext, uint32_t in_u32NumberOfEvents)
+{
+    DeferredQueue_s *psQueue = &inout_psContext->sDeferredEvents;
+    DeferredEvent_s *psDeferredEvent = NULL;
+    uint32_t u32NestingDepth = inout_psContext->u32NestingDepth + 1U;
+
+#if defined(EVENTHANDLER_USE_SINK_WORKERS)
+    if (E_TRUE == SinkWorker_IsWorkerThread())
+    {
+        psQueue = &inout_psContext->sSinkEvents;
+        u32NestingDepth = NESTING_DEPTH_OUTER;
+    }
+#endif
+
+    if ((MAX_NESTING_DEPTH < u32NestingDepth) || (DEFERRED_EVENTS_QUEUE_SIZE <= psQueue->u32NumberOfEvents))
+    {
+        inout_psContext->u32DroppedNestedEventsCounter += in_u32NumberOfEvents;
+    }
+    else
+    {
+        psDeferredEvent = &psQueue->asEvents[(psQueue->u32Head + psQueue->u32NumberOfEvents) % DEFERRED_EVENTS_QUEUE_SIZE];
+        psDeferredEvent->u32NestingDepth = u32NestingDepth;
+        psQueue->u32NumberOfEvents++;
+    }
+
+    return psDeferredEvent;
+}
+
+/**
+ * @brief Queues an event generated during processing of another event or by a sink thread,
+ *        drops it if the nesting is too deep or the queue is full
+ *
+ * @param inout_psContext           Context of the event reporter
+ * @param in_eModuleId              ID of a module, in which an event occurred
+ * @param in_u32LocationInModule    Event instance - a specific and unique place in the module
+ * @param in_eSeverity              Event severity
+ * @param in_eType                  Event type
+ * @param in_u32AdditionalData      User defined data up to 4B used for event context
+ * @param inout_pu8ContextReport    Space for the report followed by the context data in the arena, NULL if there are none
+ * @param in_u32ContextDataSize     Size of the context data in bytes
+ */
+static void EventHandler_DeferEvent(EventHandler_Context_s *inout_psContext, Modules_Id_e in_eModuleId, uint32_t in_u32LocationInModule, EventHandler_Severity_e in_eSeverity, EventHandler_Type_e in_eType, uint32_t in_u32AdditionalData, uint8_t *inout_pu8ContextReport, uint32_t in_u32ContextDataSize)
+{
+    DeferredEvent_s *psDeferredEvent = EventHandler_AddDeferredEvent(inout_psContext, 1U);
+
+    if (NULL != psDeferredEvent)
+    {
+        psDeferredEvent->eModuleId = in_eModuleId;
+        psDeferredEvent->u32LocationInModule = in_u32LocationInModule;
+        psDeferredEvent->eSeverity = in_eSeverity;
+        psDeferredEvent->eType = in_eType;
+        psDeferredEvent->u32AdditionalData = in_u32AdditionalData;
+        psDeferredEvent->pu8ContextReport = inout_pu8ContextReport;
+        psDeferredEvent->u32ContextDataSize = in_u32ContextDataSize;
+        psDeferredEvent->sBatch.u32NumberOfEvents = 0U;
+    }
+
+    return;
+}
+
+/**
+ * @brief Queues a batch generated during processing of another event or by a sink thread as one entry,
+ *        its events copied to the batch buffer of the context; those not fitting there are dropped
+ *
+ * @param inout_psContext   Context of the event reporter, its queue guarded
+ * @param in_psBatch        Events to be deferred
+ */
+static void EventHandler_DeferBatch(EventHandler_Context_s *inout_psContext, const EventHandler_EventBatch_s *in_psBatch)
+{
+    DeferredEvent_s *psDeferredEvent = NULL;
+    uint32_t u32FirstEvent = inout_psContext->u32DeferredBatchEventsSize;
+    uint32_t u32NumberOfEvents = DEFERRED_BATCH_EVENTS_SIZE - u32FirstEvent;
+    uint32_t u32IterEvent = COMMON_STARTING_INDEX_OF_ARRAY;
+
+    if (in_psBatch->u32NumberOfEvents < u32NumberOfEvents)
+    {
+        u32NumberOfEvents = in_psBatch->u32NumberOfEvents;
+    }
+
+    inout_psContext->u32DroppedNestedEventsCounter += in_psBatch->u32NumberOfEvents - u32NumberOfEvents;
+
+    if (0U != u32NumberOfEvents)
+    {
+        psDeferredEvent = EventHandler_AddDeferredEvent(inout_psContext, u32NumberOfEvents);
+    }
+
+    if (NULL != psDeferredEvent)
+    {
+        for (; u32NumberOfEvents > u32IterEvent; u32IterEvent++)
+        {
+            inout_psContext->aeDeferredBatchModuleIds[u32FirstEvent + u32IterEvent] = in_psBatch->peModuleIds[u32IterEvent];
+            inout_psContext->au32DeferredBatchLocationsInModule[u32FirstEvent + u32IterEvent] = in_psBatch->pu32LocationsInModule[u32IterEvent];
+            inout_psContext->aeDeferredBatchSeverities[u32FirstEvent + u32IterEvent] = in_psBatch->peSeverities[u32IterEvent];
+            inout_psContext->aeDeferredBatchTypes[u32FirstEvent + u32IterEvent] = in_psBatch->peTypes[u32IterEvent];
+            inout_psContext->au32DeferredBatchAdditionalData[u32FirstEvent + u32IterEvent] = (NULL != in_psBatch->pu32AdditionalData) ? in_psBatch->pu32AdditionalData[u32IterEvent] : DUMMY_USER_DATA;
+        }
+
+        inout_psContext->u32DeferredBatchEventsSize += u32NumberOfEvents;
+
+        psDeferredEvent->sBatch.peModuleIds = &inout_psContext->aeDeferredBatchModuleIds[u32FirstEvent];
+        psDeferredEvent->sBatch.pu32LocationsInModule = &inout_psContext->au32DeferredBatchLocationsInModule[u32FirstEvent];
+        psDeferredEvent->sBatch.peSeverities = &inout_psContext->aeDeferredBatchSeverities[u32FirstEvent];
+        psDeferredEvent->sBatch.peTypes = &inout_psContext->aeDeferredBatchTypes[u32FirstEvent];
+        psDeferredEvent->sBatch.pu32AdditionalData = &inout_psContext->au32DeferredBatchAdditionalData[u32FirstEvent];
+        psDeferredEvent->sBatch.u32NumberOfEvents = u32NumberOfEvents;
+    }
+
+    return;
+}
+
+/**
+ * @brief Takes the next deferred event, the nested ones go before those of the sink threads
+ *
+ * @param inout_psContext       Context of the event reporter, its queue guarded
+ * @param out_psDeferredEvent   Taken event
+ *
+ * @return E_FALSE              No event is waiting
+ * @return E_TRUE               The event has been taken
+ */
+static boolean EventHandler_TakeDeferredEvent(EventHandler_Context_s *inout_psContext, DeferredEvent_s *out_psDeferredEvent)
+{
+    DeferredQueue_s *psQueue = &inout_psContext->sDeferredEvents;
+    boolean bIsTaken = E_FALSE;
+
+#if defined(EVENTHANDLER_USE_SINK_WORKERS)
+    if (0U == psQueue->u32NumberOfEvents)
+    {
+        psQueue = &inout_psContext->sSinkEvents;
+    }
+#endif
+
+    if (0U != psQueue->u32NumberOfEvents)
+    {
+        *out_psDeferredEvent = psQueue->asEvents[psQueue->u32Head];
+        psQueue->u32Head = (psQueue->u32Head + 1U) % DEFERRED_EVENTS_QUEUE_SIZE;
+        psQueue->u32NumberOfEvents--;
+        bIsTaken = E_TRUE;
+    }
+
+    return bIsTaken;
+}
+
+/**
+ * @brief Processes the events deferred meanwhile, makes the context idle again and lets the next thread process
+ *
+ * @param inout_psContext   Context of the event reporter
+ */
+static void EventHandler_ProcessDeferredEvents(EventHandler_Context_s *inout_psContext)
+{
+    DeferredEvent_s sDeferredEvent;
+
+    EventHandler_LockQueue(inout_psContext);
+
+    while (E_TRUE == EventHandler_TakeDeferredEvent(inout_psContext, &sDeferredEvent))
+    {
+        inout_psContext->u32NestingDepth = sDeferredEvent.u32NestingDepth;
+        EventHandler_UnlockQueue(inout_psContext);
+
+        if (0U != sDeferredEvent.sBatch.u32NumberOfEvents)
+        {
+            EventHandler_ProcessBatchInChunks(inout_psContext, &sDeferredEvent.sBatch);
+        }
+        else
+        {
+            EventHandler_ProcessEvent(inout_psContext, sDeferredEvent.eModuleId, sDeferredEvent.u32LocationInModule, sDeferredEvent.eSeverity, sDeferredEvent.eType, sDeferredEvent.u32AdditionalData, sDeferredEvent.pu8ContextReport, sDeferredEvent.u32ContextDataSize);
+        }
+
+        EventHandler_LockQueue(inout_psContext);
+    }
+
+    inout_psContext->u32NestingDepth = NESTING_DEPTH_IDLE;
+    inout_psContext->u32ContextArenaSize = UNINITIALIZED_COUNTER;
+    inout_psContext->u32DeferredBatchEventsSize = UNINITIALIZED_COUNTER;
+    EventHandler_UnlockQueue(inout_psContext);
+
+#if defined(EVENTHANDLER_USE_SINK_WORKERS)
+    if (E_TRUE == inout_psContext->bAreLocksInitialized)
+    {
+        (void) pthread_mutex_unlock(&inout_psContext->sProcessingLock);
+    }
+#endif
+
+    return;
+}
+
+/**
+ * @brief Processes the events of the batch in chunks of up to EVENTHANDLER_BATCH_MAX_NUMBER_OF_EVENTS events
+ *
+ * @param inout_psContext   Context of the event reporter
+ * @param in_psBatch        Events to be handled
+ */
+static void EventHandler_ProcessBatchInChunks(EventHandler_Context_s *inout_psContext, const EventHandler_EventBatch_s *in_psBatch)
+{
+    uint32_t u32IterEvent = COMMON_STARTING_INDEX_OF_ARRAY;
+    uint32_t u32NumberOfEvents = 0U;
+
+    for (; in_psBatch->u32NumberOfEvents > u32IterEvent; u32IterEvent += u32NumberOfEvents)
+    {
+        u32NumberOfEvents = in_psBatch->u32NumberOfEvents - u32IterEvent;
+
+        if (EVENTHANDLER_BATCH_MAX_NUMBER_OF_EVENTS < u32NumberOfEvents)
+        {
+            u32NumberOfEvents = EVENTHANDLER_BATCH_MAX_NUMBER_OF_EVENTS;
+        }
+
+        EventHandler_ProcessBatch(inout_psContext, in_psBatch, u32IterEvent, u32NumberOfEvents);
+    }
+
+    return;
+}
+
+/**
+ * @brief Validates, filters and counts the events of the batch in separate passes and forwards them
+ *        to the reporting, all with the same time and the reports collected in one buffer
+ *
+ * @param inout_psContext        Context of the event reporter
+ * @param in_psBatch             Events to be handled
+ * @param in_u32FirstEvent       Index of the first event to be processed
+ * @param in_u32NumberOfEvents   Number of the events, at most EVENTHANDLER_BATCH_MAX_NUMBER_OF_EVENTS
+ */
+static void EventHandler_ProcessBatch(EventHandler_Context_s *inout_psContext, const EventHandler_EventBatch_s *in_psBatch, uint32_t in_u32FirstEvent, uint32_t in_u32NumberOfEvents)
+{
+    const Modules_Id_e *peModuleIds = &in_psBatch->peModuleIds[in_u32FirstEvent];
+    const uint32_t *pu32LocationsInModule = &in_psBatch->pu32LocationsInModule[in_u32FirstEvent];
+    const EventHandler_Severity_e *peSeverities = &in_psBatch->peSeverities[in_u32FirstEvent];
+    const EventHandler_Type_e *peTypes = &in_psBatch->peTypes[in_u32FirstEvent];
+    uint32_t au32Severity[EVENTHANDLER_BATCH_MAX_NUMBER_OF_EVENTS];
+    uint32_t au32Type[EVENTHANDLER_BATCH_MAX_NUMBER_OF_EVENTS];
+    uint32_t au32IsValid[EVENTHANDLER_BATCH_MAX_NUMBER_OF_EVENTS];
+    uint32_t au32NumberOfEventsInClass[EVENTHANDLER_NUMBER_OF_EVENT_SEVERITIES * EVENTHANDLER_NUMBER_OF_EVENT_TYPES];
+    uint32_t u32IterClass = COMMON_STARTING_INDEX_OF_ARRAY;
+    EventHandler_FilterAction_e aeFilterAction[EVENTHANDLER_BATCH_MAX_NUMBER_OF_EVENTS];
+    uint32_t u32IterEvent = COMMON_STARTING_INDEX_OF_ARRAY;
+    uint32_t u32AdditionalData = DUMMY_USER_DATA;
+    float64_t f64CurrentTimeInSeconds = EventHandler_GetTime(inout_psContext);
+
+    /* Branch-free validation pass */
+    for (u32IterEvent = COMMON_STARTING_INDEX_OF_ARRAY; in_u32NumberOfEvents > u32IterEvent; u32IterEvent++)
+    {
+        au32Severity[u32IterEvent] = (uint32_t) peSeverities[u32IterEvent];
+        au32Type[u32IterEvent] = (uint32_t) peTypes[u32IterEvent];
+        au32IsValid[u32IterEvent] = (uint32_t) (EVENTHANDLER_NUMBER_OF_EVENT_SEVERITIES > au32Severity[u32IterEvent]) & (uint32_t) (EVENTHANDLER_NUMBER_OF_EVENT_TYPES > au32Type[u32IterEvent]);
+
+        /* SRS-008 */
+        au32Severity[u32IterEvent] = ((uint32_t) E_EVENTHANDLER_TYPE_NULLARGUMENT == au32Type[u32IterEvent]) ? (uint32_t) E_EVENTHANDLER_SEVERITY_MEDIUM : au32Severity[u32IterEvent];
+    }
+
+    /* Filtering pass */
+    for (u32IterEvent = COMMON_STARTING_INDEX_OF_ARRAY; in_u32NumberOfEvents > u32IterEvent; u32IterEvent++)
+    {
+        aeFilterAction[u32IterEvent] = E_EVENTHANDLER_FILTER_DROP;
+
+        if (0U != au32IsValid[u32IterEvent])
+        {
+            EventHitters_RecordEvent(&inout_psContext->sHitters, peModuleIds[u32IterEvent], pu32LocationsInModule[u32IterEvent]);
+
+            /* SRS-013 */
+            if (E_TRUE == inout_psContext->abIsEnabledReporting[au32Type[u32IterEvent]])
+            {
+                aeFilterAction[u32IterEvent] = EventHandler_ClassifyEvent(inout_psContext, peModuleIds[u32IterEvent], pu32LocationsInModule[u32IterEvent], (EventHandler_Severity_e) au32Severity[u32IterEvent], (EventHandler_Type_e) au32Type[u32IterEvent]);
+            }
+        }
+    }
+
+    /* Counting pass, into a histogram of the event classes first */
+    for (u32IterClass = COMMON_STARTING_INDEX_OF_ARRAY; (EVENTHANDLER_NUMBER_OF_EVENT_SEVERITIES * EVENTHANDLER_NUMBER_OF_EVENT_TYPES) > u32IterClass; u32IterClass++)
+    {
+        au32NumberOfEventsInClass[u32IterClass] = UNINITIALIZED_COUNTER;
+    }
+
+    for (u32IterEvent = COMMON_STARTING_INDEX_OF_ARRAY; in_u32NumberOfEvents > u32IterEvent; u32IterEvent++)
+    {
+        if (E_EVENTHANDLER_FILTER_DROP != aeFilterAction[u32IterEvent])
+        {
+            au32NumberOfEventsInClass[(au32Severity[u32IterEvent] * EVENTHANDLER_NUMBER_OF_EVENT_TYPES) + au32Type[u32IterEvent]]++;
+        }
+    }
+
+    /* SRS-010 */
+    /* SRS-011 */
+    for (u32IterClass = COMMON_STARTING_INDEX_OF_ARRAY; (EVENTHANDLER_NUMBER_OF_EVENT_SEVERITIES * EVENTHANDLER_NUMBER_OF_EVENT_TYPES) > u32IterClass; u32IterClass++)
+    {
+        inout_psContext->au32EventsCounter[u32IterClass / EVENTHANDLER_NUMBER_OF_EVENT_TYPES][u32IterClass % EVENTHANDLER_NUMBER_OF_EVENT_TYPES] += au32NumberOfEventsInClass[u32IterClass];
+    }
+
+    EventStatistics_RecordEvents(&inout_psContext->sStatistics, f64CurrentTimeInSeconds, au32NumberOfEventsInClass);
+
+    /* Reporting pass, in the order of the events */
+    inout_psContext->bIsBatching = E_TRUE;
+
+    for (u32IterEvent = COMMON_STARTING_INDEX_OF_ARRAY; in_u32NumberOfEvents > u32IterEvent; u32IterEvent++)
+    {
+        if (NULL != in_psBatch->pu32AdditionalData)
+        {
+            u32AdditionalData = in_psBatch->pu32AdditionalData[in_u32FirstEvent + u32IterEvent];
+        }
+
+        if (EVENTHANDLER_NUMBER_OF_EVENT_TYPES <= au32Type[u32IterEvent])
+        {
+            /* Someone forgot to change (increment) the definition of EVENTHANDLER_NUMBER_OF_EVENT_TYPES when adding some new enums */
+            EventHandler_ComposeAndSendReport(inout_psContext, f64CurrentTimeInSeconds, m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_GENERATEEVENTREPORTUSERDATA_TYPES, E_EVENTHANDLER_SEVERITY_NORMAL, E_EVENTHANDLER_TYPE_UNUPDATEDCONSTANTS, au32Type[u32IterEvent], NULL, 0U);
+        }
+        else if (0U == au32IsValid[u32IterEvent])
+        {
+            /* Someone forgot to change (increment) the definition of EVENTHANDLER_NUMBER_OF_EVENT_SEVERITIES when adding some new enums */
+            EventHandler_ComposeAndSendReport(inout_psContext, f64CurrentTimeInSeconds, m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_GENERATEEVENTREPORTUSERDATA_SEVERITIES, E_EVENTHANDLER_SEVERITY_NORMAL, E_EVENTHANDLER_TYPE_UNUPDATEDCONSTANTS, (uint32_t) peSeverities[u32IterEvent], NULL, 0U);
+        }
+        else if (E_EVENTHANDLER_FILTER_ALLOW == aeFilterAction[u32IterEvent])
+        {
+            EventHandler_ForwardEvent(inout_psContext, f64CurrentTimeInSeconds, peModuleIds[u32IterEvent], pu32LocationsInModule[u32IterEvent], (EventHandler_Severity_e) au32Severity[u32IterEvent], (EventHandler_Type_e) au32Type[u32IterEvent], u32AdditionalData, NULL, 0U);
+        }
+        else
+        {
+            ;
+        }
+    }
+
+    EventHandler_FlushBatchReports(inout_psContext);
+    inout_psContext->bIsBatching = E_FALSE;
+
+    return;
+}
+
+/**
+ * @brief Validates, filters and counts the event and forwards it to the reporting
+ *
+ * @param inout_psContext           Context of the event reporter
+ * @param in_eModuleId              ID of a module, in which an event occurred
+ * @param in_u32LocationInModule    Event instance - a specific and unique place in the module
+ * @param in_eSeverity              Event severity
+ * @param in_eType                  Event type
+ * @param in_u32AdditionalData      User defined data up to 4B used for event context
+ * @param inout_pu8ContextReport    Space for the report followed by the context data in the arena, NULL if there are none
+ * @param in_u32ContextDataSize     Size of the context data in bytes
+ */
+static void EventHandler_ProcessEvent(EventHandler_Context_s *inout_psContext, Modules_Id_e in_eModuleId, uint32_t in_u32LocationInModule, EventHandler_Severity_e in_eSeverity, EventHandler_Type_e in_eType, uint32_t in_u32AdditionalData, uint8_t *inout_pu8ContextReport, uint32_t in_u32ContextDataSize)
+{
+    EventHandler_FilterAction_e eFilterAction = E_EVENTHANDLER_FILTER_ALLOW;
+    float64_t f64CurrentTimeInSeconds = TIMING_INITIAL_TIME;
+
+    if (EVENTHANDLER_NUMBER_OF_EVENT_TYPES > in_eType)
+    {
+        if (EVENTHANDLER_NUMBER_OF_EVENT_SEVERITIES > in_eSeverity)
+        {
+            /* The sources are tracked before any filtering, so the muted ones show up as well */
+            EventHitters_RecordEvent(&inout_psContext->sHitters, in_eModuleId, in_u32LocationInModule);
+
+            /* SRS-013 */
+            if (E_TRUE == inout_psContext->abIsEnabledReporting[in_eType])
+            {
+                /* SRS-008 */
+                if ((E_EVENTHANDLER_TYPE_NULLARGUMENT == in_eType) && (E_EVENTHANDLER_SEVERITY_MEDIUM > in_eSeverity))
+                {
+                    in_eSeverity = E_EVENTHANDLER_SEVERITY_MEDIUM;
+                }
+
+                eFilterAction = EventHandler_ClassifyEvent(inout_psContext, in_eModuleId, in_u32LocationInModule, in_eSeverity, in_eType);
+
+                if (E_EVENTHANDLER_FILTER_DROP != eFilterAction)
+                {
+                    f64CurrentTimeInSeconds = EventHandler_GetTime(inout_psContext);
+
+                    /* SRS-010 */
+                    /* SRS-011 */
+                    inout_psContext->au32EventsCounter[in_eSeverity][in_eType]++;
+                    EventStatistics_RecordEvent(&inout_psContext->sStatistics, f64CurrentTimeInSeconds, in_eSeverity, in_eType);
+
+                    if (E_EVENTHANDLER_FILTER_ALLOW == eFilterAction)
+                    {
+                        EventHandler_ForwardEvent(inout_psContext, f64CurrentTimeInSeconds, in_eModuleId, in_u32LocationInModule, in_eSeverity, in_eType, in_u32AdditionalData, inout_pu8ContextReport, in_u32ContextDataSize);
+                    }
+                }
+            }
+        }
+        else
+        {
+            /* Someone forgot to change (increment) the definition of EVENTHANDLER_NUMBER_OF_EVENT_SEVERITIES when adding some new enums */
+            EventHandler_ComposeAndSendReport(inout_psContext, EventHandler_GetTime(inout_psContext), m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_GENERATEEVENTREPORTUSERDATA_SEVERITIES, E_EVENTHANDLER_SEVERITY_NORMAL, E_EVENTHANDLER_TYPE_UNUPDATEDCONSTANTS, (uint32_t) in_eSeverity, NULL, 0U);
+        }
+    }
+    else
+    {
+        /* Someone forgot to change (increment) the definition of EVENTHANDLER_NUMBER_OF_EVENT_TYPES when adding some new enums */
+        EventHandler_ComposeAndSendReport(inout_psContext, EventHandler_GetTime(inout_psContext), m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_GENERATEEVENTREPORTUSERDATA_TYPES, E_EVENTHANDLER_SEVERITY_NORMAL, E_EVENTHANDLER_TYPE_UNUPDATEDCONSTANTS, (uint32_t) in_eType, NULL, 0U);
+    }
+
+    return;
+}
+
+/**
+ * @brief Applies the Standby mode logic to the counted event, reports it and resets the system for MEDIUM severity
+ *
+ * @param inout_psContext              Context of the event reporter
+ * @param in_f64CurrentTimeInSeconds   Current time from system start in seconds
+ * @param in_eModuleId                 ID of a module, in which an event occurred
+ * @param in_u32LocationInModule       Event instance - a specific and unique place in the module
+ * @param in_eSeverity                 Event severity (already validated)
+ * @param in_eType                     Event type (already validated)
+ * @param in_u32AdditionalData         User defined data up to 4B used for event context
+ * @param inout_pu8ContextReport       Space for the report followed by the context data in the arena, NULL if there are none
+ * @param in_u32ContextDataSize        Size of the context data in bytes
+ */
+static void EventHandler_ForwardEvent(EventHandler_Context_s *inout_psContext, float64_t in_f64CurrentTimeInSeconds, Modules_Id_e in_eModuleId, uint32_t in_u32LocationInModule, EventHandler_Severity_e in_eSeverity, EventHandler_Type_e in_eType, uint32_t in_u32AdditionalData, uint8_t *inout_pu8ContextReport, uint32_t in_u32ContextDataSize)
+{
+    if (E_EVENTHANDLER_SEVERITY_MEDIUM > in_eSeverity)
+    {
+        if (E_TRUE == inout_psContext->abIsStandbyMode[in_eType])
+        {
+            /* SRS-009 */
+            if ((inout_psContext->af64LastTime[in_eType] + m_f64ReenableReportingAfterSeconds) < in_f64CurrentTimeInSeconds)
+            {
+                /* SRS-012 */
+                inout_psContext->abIsStandbyMode[in_eType] = E_FALSE;
+                inout_psContext->af64LastTime[in_eType] = in_f64CurrentTimeInSeconds;
+                EventHandler_ComposeAndSendReport(inout_psContext, in_f64CurrentTimeInSeconds, in_eModuleId, in_u32LocationInModule, in_eSeverity, in_eType, in_u32AdditionalData, inout_pu8ContextReport, in_u32ContextDataSize);
+            }
+        }
+        else
+        {
+            /* SRS-009 */
+            if ((inout_psContext->af64LastTime[in_eType] + OVERFLOW_LIMIT_IN_SECONDS) > in_f64CurrentTimeInSeconds)
+            {
+                /* SRS-011 */
+                inout_psContext->abIsStandbyMode[in_eType] = E_TRUE;
+            }
+
+            inout_psContext->af64LastTime[in_eType] = in_f64CurrentTimeInSeconds;
+            EventHandler_ComposeAndSendReport(inout_psContext, in_f64CurrentTimeInSeconds, in_eModuleId, in_u32LocationInModule, in_eSeverity, in_eType, in_u32AdditionalData, inout_pu8ContextReport, in_u32ContextDataSize);
+        }
+    }
+    else
+    {
+        EventHandler_ComposeAndSendReport(inout_psContext, in_f64CurrentTimeInSeconds, in_eModuleId, in_u32LocationInModule, in_eSeverity, in_eType, in_u32AdditionalData, inout_pu8ContextReport, in_u32ContextDataSize);
+
+        /* SRS-004 */
+        if (E_EVENTHANDLER_SEVERITY_MEDIUM == in_eSeverity)
+        {
+            EventHandler_FlushBatchReports(inout_psContext);
+            EventHandler_InitializeBeforeReset(inout_psContext);
+
+            if (E_TRUE == inout_psContext->bIsEnabledReset)
+            {
+#if defined(EVENTHANDLER_USE_SINK_WORKERS)
+                /* The report explaining the reset must reach the sinks first */
+                SinkWorker_Flush();
+#endif
+                SystemReset_ResetSystem();
+            }
+            else
+            {
+                /* The context goes on as after the reset */
+                inout_psContext->u32SuppressedResetsCounter++;
+            }
+        }
+    }
+
+    return;
+}
+
+/**
+ * @brief Looks the event up in the compiled filter tables
+ *
+ * @param in_psContext              Context of the event reporter
+ * @param in_eModuleId              ID of a module, in which an event occurred
+ * @param in_u32LocationInModule    Event instance - a specific and unique place in the module
+ * @param in_eSeverity              Event severity (already validated)
+ * @param in_eType                  Event type (already validated)
+ *
+ * @return                          Action of the last matching filter rule, E_EVENTHANDLER_FILTER_ALLOW if none matches
+ */
+static EventHandler_FilterAction_e EventHandler_ClassifyEvent(const EventHandler_Context_s *in_psContext, Modules_Id_e in_eModuleId, uint32_t in_u32LocationInModule, EventHandler_Severity_e in_eSeverity, EventHandler_Type_e in_eType)
+{
+    EventHandler_FilterAction_e eFilterAction = E_EVENTHANDLER_FILTER_ALLOW;
+    uint32_t u32Bit = 1U << (((uint32_t) in_eSeverity * EVENTHANDLER_NUMBER_OF_EVENT_TYPES) + (uint32_t) in_eType);
+
+    if (MODULES_NUMBER_OF_IDS > (uint32_t) in_eModuleId)
+    {
+        if (EVENTHANDLER_FILTER_NUMBER_OF_LOCATIONS < in_u32LocationInModule)
+        {
+            in_u32LocationInModule = EVENTHANDLER_FILTER_NUMBER_OF_LOCATIONS;
+        }
+
+        if (0U != (in_psContext->au32FilterDropMask[in_eModuleId][in_u32LocationInModule] & u32Bit))
+        {
+            eFilterAction = E_EVENTHANDLER_FILTER_DROP;
+        }
+        else if (0U != (in_psContext->au32FilterCountOnlyMask[in_eModuleId][in_u32LocationInModule] & u32Bit))
+        {
+            eFilterAction = E_EVENTHANDLER_FILTER_COUNTONLY;
+        }
+        else
+        {
+            ;
+        }
+    }
+
+    return eFilterAction;
+}
+
+/**
+ * @brief Composes the event report (data) and hands it over to all sinks of the context,
+ *        or adds it to the reports of the batch being processed.
+ *        A report with context data is composed in front of them in the arena and handed over from there.
+ *
+ * @param inout_psContext            Context of the event reporter
+ * @param in_f64CurrentTimeInSeconds Current time from system start in seconds
+ * @param in_eModuleId               ID of a module, in which an event occurred
+ * @param in_u32LocationInModule     Event instance - a specific and unique place in the module
+ * @param in_eSeverity               Event severity
+ * @param in_eType                   Event type
+ * @param in_u32AdditionalData       User defined data up to 4B used for event context
+ * @param inout_pu8ContextReport     Space for the report followed by the context data in the arena, NULL if there are none
+ * @param in_u32ContextDataSize      Size of the context data in bytes
+ */
+static void EventHandler_ComposeAndSendReport(EventHandler_Context_s *inout_psContext, float64_t in_f64CurrentTimeInSeconds, Modules_Id_e in_eModuleId, uint32_t in_u32LocationInModule, EventHandler_Severity_e in_eSeverity, EventHandler_Type_e in_eType, uint32_t in_u32AdditionalData, uint8_t *inout_pu8ContextReport, uint32_t in_u32ContextDataSize)
+{
+    uint32_t u32IterSink = COMMON_STARTING_INDEX_OF_ARRAY;
+    uint8_t au8EventData[EVENT_DATA_SIZE_IN_BYTES];
+
+    if (NULL != inout_pu8ContextReport)
+    {
+        EventHandler_ComposeReport(inout_pu8ContextReport, in_f64CurrentTimeInSeconds, in_eModuleId, in_u32LocationInModule, in_eSeverity, in_eType, in_u32AdditionalData, inout_psContext->u32NextSequenceNumber, in_u32ContextDataSize);
+
+        for (; inout_psContext->u32NumberOfSinks > u32IterSink; u32IterSink++)
+        {
+            inout_psContext->apfSinks[u32IterSink](inout_pu8ContextReport, EVENT_DATA_SIZE_IN_BYTES + in_u32ContextDataSize);
+        }
+    }
+    else if (E_TRUE == inout_psContext->bIsBatching)
+    {
+        if ((inout_psContext->u32BatchReportsSize + EVENT_DATA_SIZE_IN_BYTES) > sizeof(inout_psContext->au8BatchReports))
+        {
+            EventHandler_FlushBatchReports(inout_psContext);
+        }
+
+        EventHandler_ComposeReport(&inout_psContext->au8BatchReports[inout_psContext->u32BatchReportsSize], in_f64CurrentTimeInSeconds, in_eModuleId, in_u32LocationInModule, in_eSeverity, in_eType, in_u32AdditionalData, inout_psContext->u32NextSequenceNumber, 0U);
+        inout_psContext->u32BatchReportsSize += EVENT_DATA_SIZE_IN_BYTES;
+    }
+    else
+    {
+        EventHandler_ComposeReport(au8EventData, in_f64CurrentTimeInSeconds, in_eModuleId, in_u32LocationInModule, in_eSeverity, in_eType, in_u32AdditionalData, inout_psContext->u32NextSequenceNumber, 0U);
+
+        for (; inout_psContext->u32NumberOfSinks > u32IterSink; u32IterSink++)
+        {
+            inout_psContext->apfSinks[u32IterSink](au8EventData, EVENT_DATA_SIZE_IN_BYTES);
+        }
+    }
+
+    inout_psContext->u32NextSequenceNumber++;
+
+    return;
+}
+
+/**
+ * @brief Composes the event report (data)
+ *
+ * @param out_pu8EventData           Report of EVENT_DATA_SIZE_IN_BYTES
+ * @param in_f64CurrentTimeInSeconds Current time from system start in seconds
+ * @param in_eModuleId               ID of a module, in which an event occurred
+ * @param in_u32LocationInModule     Event instance - a specific and unique place in the module
+ * @param in_eSeverity               Event severity
+ * @param in_eType                   Event type
+ * @param in_u32AdditionalData       User defined data up to 4B used for event context
+ * @param in_u32SequenceNumber       Number of the report within the context, the receiver detects lost reports by it
+ * @param in_u32ContextDataSize      Size of the context data following the report in bytes
+ */
+static void EventHandler_ComposeReport(uint8_t *out_pu8EventData, float64_t in_f64CurrentTimeInSeconds, Modules_Id_e in_eModuleId, uint32_t in_u32LocationInModule, EventHandler_Severity_e in_eSeverity, EventHandler_Type_e in_eType, uint32_t in_u32AdditionalData, uint32_t in_u32SequenceNumber, uint32_t in_u32ContextDataSize)
+{
+    ConversionFloatToByte_u uAuxiliaryConversion;
+    uint32_t u32IterBytes = COMMON_STARTING_INDEX_OF_ARRAY;
+    uint8_t *pu8EventData = out_pu8EventData;
+    uint8_t *pu8EventDataBoundary = out_pu8EventData + EVENT_DATA_SIZE_IN_BYTES;
+
+    uAuxiliaryConversion.f64Variable = in_f64CurrentTimeInSeconds;
+
+    if (pu8EventDataBoundary >= (pu8EventData + COMMON_FLOAT64_SIZE_IN_BYTES))
+    {
+        for (; COMMON_FLOAT64_SIZE_IN_BYTES > u32IterBytes; u32IterBytes++)
+        {
+            *pu8EventData = uAuxiliaryConversion.au8Buffer[u32IterBytes];
+            pu8EventData++;
+        }
+    }
+
+    EventHandler_Convert32BitNumberToByteArray((uint32_t) in_eModuleId, &pu8EventData, pu8EventDataBoundary);
+    EventHandler_Convert32BitNumberToByteArray(in_u32LocationInModule, &pu8EventData, pu8EventDataBoundary);
+    EventHandler_Convert32BitNumberToByteArray((uint32_t) in_eSeverity, &pu8EventData, pu8EventDataBoundary);
+    EventHandler_Convert32BitNumberToByteArray((uint32_t) in_eType, &pu8EventData, pu8EventDataBoundary);
+    EventHandler_Convert32BitNumberToByteArray(in_u32AdditionalData, &pu8EventData, pu8EventDataBoundary);
+    EventHandler_Convert32BitNumberToByteArray(in_u32SequenceNumber, &pu8EventData, pu8EventDataBoundary);
+    EventHandler_Convert32BitNumberToByteArray(in_u32ContextDataSize, &pu8EventData, pu8EventDataBoundary);
+
+    return;
+}
+
+/**
+ * @brief Hands the collected reports of the batch over to all sinks of the context at once
+ *
+ * @param inout_psContext   Context of the event reporter
+ */
+static void EventHandler_FlushBatchReports(EventHandler_Context_s *inout_psContext)
+{
+    uint32_t u32IterSink = COMMON_STARTING_INDEX_OF_ARRAY;
+
+    if (0U != inout_psContext->u32BatchReportsSize)
+    {
+        for (; inout_psContext->u32NumberOfSinks > u32IterSink; u32IterSink++)
+        {
+            inout_psContext->apfSinks[u32IterSink](inout_psContext->au8BatchReports, inout_psContext->u32BatchReportsSize);
+        }
+
+        inout_psContext->u32BatchReportsSize = UNINITIALIZED_COUNTER;
+    }
+
+    return;
+}
+
+/**
+ * @brief Takes a 32-bit number, splits it into 4 1-Byte-long pieces and writes them into the provided array
+ *
+ * @param in_u32Number       Number, which shall be converted
+ * @param inout_ppu8Data     Pointer to the beginning pointer of the provided array
+ * @param in_pu8DataBoundary Pointer, which stands right after the provided array
+ */
+static void EventHandler_Convert32BitNumberToByteArray(uint32_t in_u32Number, uint8_t **inout_ppu8Data, const uint8_t * const in_pu8DataBoundary)
+{
+    uint8_t *pu8Data;
+
+    pu8Data = *inout_ppu8Data + COMMON_UINT32_SIZE_IN_BYTES;
+
+    if (in_pu8DataBoundary >= pu8Data)
+    {
+        while (pu8Data > *inout_ppu8Data)
+        {
+            pu8Data--;
+            *pu8Data = (uint8_t) (in_u32Number & EXTRACT_ONE_BYTE);
+            in_u32Number >>= COMMON_BYTE_SIZE_IN_BITS;
+        }
+
+        *inout_ppu8Data += COMMON_UINT32_SIZE_IN_BYTES;
+    }
+
+    return;
+}
+
+/**
+ * @brief Gets the number of the generated events of the specified event severity and type in the specified context
+ *
+ * @param inout_psContext   Context of the event reporter
+ * @param in_eSeverity      Defined event severity
+ * @param in_eType          Defined event type
+ *
+ * @return                  Number of the generated events
+ */
+uint32_t EventHandler_ContextGetEventsCounter(EventHandler_Context_s *inout_psContext, EventHandler_Severity_e in_eSeverity, EventHandler_Type_e in_eType)
+{
+    uint32_t u32EventsCounter = UNINITIALIZED_COUNTER;
+
+    if (NULL == inout_psContext)
+    {
+        EventHandler_GenerateEventReport(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_CONTEXTGETEVENTSCOUNTER_NULL, E_EVENTHANDLER_SEVERITY_MEDIUM, E_EVENTHANDLER_TYPE_NULLARGUMENT);
+    }
+    else if (EVENTHANDLER_NUMBER_OF_EVENT_SEVERITIES > in_eSeverity)
+    {
+        if (EVENTHANDLER_NUMBER_OF_EVENT_TYPES > in_eType)
+        {
+            u32EventsCounter = inout_psContext->au32EventsCounter[in_eSeverity][in_eType];
+        }
+        else
+        {
+            /* Someone may have forgotten to change (increment) the definition of EVENTHANDLER_NUMBER_OF_EVENT_TYPES when adding some new enums */
+            EventHandler_ContextGenerateEventReportUserData(inout_psContext, m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_GETEVENTSCOUNTER_TYPES, E_EVENTHANDLER_SEVERITY_NORMAL, E_EVENTHANDLER_TYPE_UNUPDATEDCONSTANTS, (uint32_t) in_eType);
+        }
+    }
+    else
+    {
+        /* Someone may have forgotten to change (increment) the definition of EVENTHANDLER_NUMBER_OF_EVENT_SEVERITIES when adding some new enums */
+        EventHandler_ContextGenerateEventReportUserData(inout_psContext, m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_GETEVENTSCOUNTER_SEVERITIES, E_EVENTHANDLER_SEVERITY_NORMAL, E_EVENTHANDLER_TYPE_UNUPDATEDCONSTANTS, (uint32_t) in_eSeverity);
+    }
+
+    return u32EventsCounter;
+}
+
+/**
+ * @brief Gets the status of the Standby mode for the specified event type in the specified context
+ *
+ * @param inout_psContext   Context of the event reporter
+ * @param in_eType          Defined event type
+ *
+ * @return E_FALSE          No Standby mode for the event type - the event report is processed
+ * @return E_TRUE           Standby mode for the event type is active - the event report is not further processed
+ */
+boolean EventHandler_ContextGetStandbyMode(EventHandler_Context_s *inout_psContext, EventHandler_Type_e in_eType)
+{
+    boolean bIsStandbyMode = E_FALSE;
+
+    if (NULL == inout_psContext)
+    {
+        EventHandler_GenerateEventReport(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_CONTEXTGETSTANDBYMODE_NULL, E_EVENTHANDLER_SEVERITY_MEDIUM, E_EVENTHANDLER_TYPE_NULLARGUMENT);
+    }
+    else if (EVENTHANDLER_NUMBER_OF_EVENT_TYPES > in_eType)
+    {
+        bIsStandbyMode = inout_psContext->abIsStandbyMode[in_eType];
+    }
+    else
+    {
+        /* Someone may have forgotten to change (increment) the definition of EVENTHANDLER_NUMBER_OF_EVENT_TYPES when adding some new enums */
+        EventHandler_ContextGenerateEventReportUserData(inout_psContext, m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_GETSTANDBYMODE_TYPES, E_EVENTHANDLER_SEVERITY_NORMAL, E_EVENTHANDLER_TYPE_UNUPDATEDCONSTANTS, (uint32_t) in_eType);
+    }
+
+    return bIsStandbyMode;
+}
+
+/**
+ * @brief Gets, whether the event reporting is enabled / disabled for the selected event type in the specified context
+ *
+ * @param inout_psContext   Context of the event reporter
+ * @param in_eType          Defined event type
+ *
+ * @return E_FALSE          The event report processing is disabled for the selected event type
+ * @return E_TRUE           The event report processing is active for the selected event type
+ */
+boolean EventHandler_ContextGetEnabledReporting(EventHandler_Context_s *inout_psContext, EventHandler_Type_e in_eType)
+{
+    boolean bIsEnabledReporting = E_FALSE;
+
+    if (NULL == inout_psContext)
+    {
+        EventHandler_GenerateEventReport(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_CONTEXTGETENABLEDREPORTING_NULL, E_EVENTHANDLER_SEVERITY_MEDIUM, E_EVENTHANDLER_TYPE_NULLARGUMENT);
+    }
+    else if (EVENTHANDLER_NUMBER_OF_EVENT_TYPES > in_eType)
+    {
+        bIsEnabledReporting = inout_psContext->abIsEnabledReporting[in_eType];
+    }
+    else
+    {
+        /* Someone may have forgotten to change (increment) the definition of EVENTHANDLER_NUMBER_OF_EVENT_TYPES when adding some new enums */
+        EventHandler_ContextGenerateEventReportUserData(inout_psContext, m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_GETENABLEDREPORTING_TYPES, E_EVENTHANDLER_SEVERITY_NORMAL, E_EVENTHANDLER_TYPE_UNUPDATEDCONSTANTS, (uint32_t) in_eType);
+    }
+
+    return bIsEnabledReporting;
+}
+
+/* SRS-013 */
+/**
+ * @brief Sets, whether the event reporting is enabled / disabled for each event type separately in the specified context
+ *
+ * @param inout_psContext   Context of the event reporter
+ * @param in_eType          Defined event type
+ * @param in_bIsEnabled     Enables or disables the event reporting for the selected event type
+ */
+void EventHandler_ContextSetEnabledReporting(EventHandler_Context_s *inout_psContext, EventHandler_Type_e in_eType, boolean in_bIsEnabled)
+{
+    if (NULL == inout_psContext)
+    {
+        EventHandler_GenerateEventReport(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_CONTEXTSETENABLEDREPORTING_NULL, E_EVENTHANDLER_SEVERITY_MEDIUM, E_EVENTHANDLER_TYPE_NULLARGUMENT);
+    }
+    else if (EVENTHANDLER_NUMBER_OF_EVENT_TYPES > in_eType)
+    {
+        inout_psContext->abIsEnabledReporting[in_eType] = in_bIsEnabled;
+    }
+    else
+    {
+        /* Someone may have forgotten to change (increment) the definition of EVENTHANDLER_NUMBER_OF_EVENT_TYPES when adding some new enums */
+        EventHandler_ContextGenerateEventReportUserData(inout_psContext, m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_SETENABLEDREPORTING_TYPES, E_EVENTHANDLER_SEVERITY_NORMAL, E_EVENTHANDLER_TYPE_UNUPDATEDCONSTANTS, (uint32_t) in_eType);
+    }
+
+    return;
+}
+
+/**
+ * @brief Gets the number of events, which were generated during processing of another event in the specified context
+ *        and dropped, because the nesting was too deep or the queue of deferred events was full
+ *
+ * @param inout_psContext   Context of the event reporter
+ *
+ * @return                  Number of the dropped nested events
+ */
+uint32_t EventHandler_ContextGetDroppedNestedEventsCounter(EventHandler_Context_s *inout_psContext)
+{
+    uint32_t u32DroppedNestedEventsCounter = UNINITIALIZED_COUNTER;
+
+    if (NULL == inout_psContext)
+    {
+        EventHandler_GenerateEventReport(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_CONTEXTGETDROPPEDNESTEDEVENTS_NULL, E_EVENTHANDLER_SEVERITY_MEDIUM, E_EVENTHANDLER_TYPE_NULLARGUMENT);
+    }
+    else
+    {
+        u32DroppedNestedEventsCounter = inout_psContext->u32DroppedNestedEventsCounter;
+    }
+
+    return u32DroppedNestedEventsCounter;
+}
+
+/**
+ * @brief Gets the number of events reported in the specified context without their context data, because the arena was full
+ *
+ * @param inout_psContext   Context of the event reporter
+ *
+ * @return                  Number of the dropped context data
+ */
+uint32_t EventHandler_ContextGetDroppedContextDataCounter(EventHandler_Context_s *inout_psContext)
+{
+    uint32_t u32DroppedContextDataCounter = UNINITIALIZED_COUNTER;
+
+    if (NULL == inout_psContext)
+    {
+        EventHandler_GenerateEventReport(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_CONTEXTGETDROPPEDCONTEXTDATACOUNTER_NULL, E_EVENTHANDLER_SEVERITY_MEDIUM, E_EVENTHANDLER_TYPE_NULLARGUMENT);
+    }
+    else
+    {
+        u32DroppedContextDataCounter = inout_psContext->u32DroppedContextDataCounter;
+    }
+
+    return u32DroppedContextDataCounter;
+}
+
+/**
+ * @brief Sets, whether a MEDIUM event resets the system in the specified context; if not, the context goes on
+ *        as after the reset and the reset is counted, e.g. for a simulation on the host
+ *
+ * @param inout_psContext   Context of the event reporter
+ * @param in_bIsEnabled     Enables or disables the reset
+ */
+void EventHandler_ContextSetEnabledReset(EventHandler_Context_s *inout_psContext, boolean in_bIsEnabled)
+{
+    if (NULL == inout_psContext)
+    {
+        EventHandler_GenerateEventReport(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_CONTEXTSETENABLEDRESET_NULL, E_EVENTHANDLER_SEVERITY_MEDIUM, E_EVENTHANDLER_TYPE_NULLARGUMENT);
+        return;
+    }
+
+    inout_psContext->bIsEnabledReset = in_bIsEnabled;
+
+    return;
+}
+
+/**
+ * @brief Sets the clock of the event times in the specified context, e.g. a virtual time of a simulation
+ *
+ * @param inout_psContext   Context of the event reporter
+ * @param in_pfTimeSource   Clock giving the time in seconds, NULL for Timing_GetTime
+ */
+void EventHandler_ContextSetTimeSource(EventHandler_Context_s *inout_psContext, EventHandler_TimeSource_f in_pfTimeSource)
+{
+    if (NULL == inout_psContext)
+    {
+        EventHandler_GenerateEventReport(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_CONTEXTSETTIMESOURCE_NULL, E_EVENTHANDLER_SEVERITY_MEDIUM, E_EVENTHANDLER_TYPE_NULLARGUMENT);
+        return;
+    }
+
+    inout_psContext->pfTimeSource = in_pfTimeSource;
+
+    return;
+}
+
+/**
+ * @brief Gets the number of MEDIUM events in the specified context, which did not reset the system, because the reset was disabled
+ *
+ * @param inout_psContext   Context of the event reporter
+ *
+ * @return                  Number of the suppressed resets
+ */
+uint32_t EventHandler_ContextGetSuppressedResetsCounter(EventHandler_Context_s *inout_psContext)
+{
+    uint32_t u32SuppressedResetsCounter = UNINITIALIZED_COUNTER;
+
+    if (NULL == inout_psContext)
+    {
+        EventHandler_GenerateEventReport(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_CONTEXTGETSUPPRESSEDRESETSCOUNTER_NULL, E_EVENTHANDLER_SEVERITY_MEDIUM, E_EVENTHANDLER_TYPE_NULLARGUMENT);
+    }
+    else
+    {
+        u32SuppressedResetsCounter = inout_psContext->u32SuppressedResetsCounter;
+    }
+
+    return u32SuppressedResetsCounter;
+}
+
+/**
+ * @brief Gets the sequence number, which the next report of the specified context will carry
+ *
+ * @param inout_psContext   Context of the event reporter
+ *
+ * @return                  Sequence number of the next report
+ */
+uint32_t EventHandler_ContextGetNextSequenceNumber(EventHandler_Context_s *inout_psContext)
+{
+    uint32_t u32NextSequenceNumber = UNINITIALIZED_COUNTER;
+
+    if (NULL == inout_psContext)
+    {
+        EventHandler_GenerateEventReport(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_CONTEXTGETNEXTSEQUENCENUMBER_NULL, E_EVENTHANDLER_SEVERITY_MEDIUM, E_EVENTHANDLER_TYPE_NULLARGUMENT);
+    }
+    else
+    {
+        u32NextSequenceNumber = inout_psContext->u32NextSequenceNumber;
+    }
+
+    return u32NextSequenceNumber;
+}
+
+/**
+ * @brief Gets the rate of the events of the specified event severity and type within the rolling window of the specified context
+ *
+ * Counted are all events passing the filters, including the ones suppressed by the Standby mode.
+ *
+ * @param inout_psContext   Context of the event reporter
+ * @param in_eSeverity      Defined event severity
+ * @param in_eType          Defined event type
+ * @param in_eWindow        Defined rolling window
+ *
+ * @return                  Events per minute averaged over the window
+ */
+float64_t EventHandler_ContextGetEventsRate(EventHandler_Context_s *inout_psContext, EventHandler_Severity_e in_eSeverity, EventHandler_Type_e in_eType, EventHandler_RateWindow_e in_eWindow)
+{
+    float64_t f64EventsRate = 0.0;
+
+    if (NULL == inout_psContext)
+    {
+        EventHandler_GenerateEventReport(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_CONTEXTGETEVENTSRATE_NULL, E_EVENTHANDLER_SEVERITY_MEDIUM, E_EVENTHANDLER_TYPE_NULLARGUMENT);
+    }
+    else if (EVENTHANDLER_NUMBER_OF_EVENT_SEVERITIES <= in_eSeverity)
+    {
+        /* Someone may have forgotten to change (increment) the definition of EVENTHANDLER_NUMBER_OF_EVENT_SEVERITIES when adding some new enums */
+        EventHandler_ContextGenerateEventReportUserData(inout_psContext, m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_GETEVENTSRATE_SEVERITIES, E_EVENTHANDLER_SEVERITY_NORMAL, E_EVENTHANDLER_TYPE_UNUPDATEDCONSTANTS, (uint32_t) in_eSeverity);
+    }
+    else if (EVENTHANDLER_NUMBER_OF_EVENT_TYPES <= in_eType)
+    {
+        /* Someone may have forgotten to change (increment) the definition of EVENTHANDLER_NUMBER_OF_EVENT_TYPES when adding some new enums */
+        EventHandler_ContextGenerateEventReportUserData(inout_psContext, m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_GETEVENTSRATE_TYPES, E_EVENTHANDLER_SEVERITY_NORMAL, E_EVENTHANDLER_TYPE_UNUPDATEDCONSTANTS, (uint32_t) in_eType);
+    }
+    else if (EVENTHANDLER_NUMBER_OF_RATE_WINDOWS <= in_eWindow)
+    {
+        /* Someone may have forgotten to change (increment) the definition of EVENTHANDLER_NUMBER_OF_RATE_WINDOWS when adding some new enums */
+        EventHandler_ContextGenerateEventReportUserData(inout_psContext, m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_GETEVENTSRATE_WINDOWS, E_EVENTHANDLER_SEVERITY_NORMAL, E_EVENTHANDLER_TYPE_UNUPDATEDCONSTANTS, (uint32_t) in_eWindow);
+    }
+    else
+    {
+        f64EventsRate = EventStatistics_GetRate(&inout_psContext->sStatistics, EventHandler_GetTime(inout_psContext), in_eSeverity, in_eType, in_eWindow);
+    }
+
+    return f64EventsRate;
+}
+
+/**
+ * @brief Gets the event sources (module, location) generating most of the events in the specified context,
+ *        ordered from the noisiest one
+ *
+ * All valid events are tracked, including the ones dropped by the filters or the disabled reporting.
+ * Every source generating more than 1 / (EVENTHITTERS_NUMBER_OF_ENTRIES + 1) of the events is reported.
+ *
+ * @param inout_psContext                 Context of the event reporter
+ * @param out_psHeavyHitters              Array for the heavy hitters
+ * @param in_u32MaxNumberOfHeavyHitters   Size of the array
+ *
+ * @return                                Number of the heavy hitters written into the array
+ */
+uint32_t EventHandler_ContextGetHeavyHitters(EventHandler_Context_s *inout_psContext, EventHitters_HeavyHitter_s *out_psHeavyHitters, uint32_t in_u32MaxNumberOfHeavyHitters)
+{
+    uint32_t u32NumberOfHeavyHitters = UNINITIALIZED_COUNTER;
+
+    if (NULL == inout_psContext)
+    {
+        EventHandler_GenerateEventReport(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_CONTEXTGETHEAVYHITTERS_NULL, E_EVENTHANDLER_SEVERITY_MEDIUM, E_EVENTHANDLER_TYPE_NULLARGUMENT);
+    }
+    else if (NULL == out_psHeavyHitters)
+    {
+        EventHandler_ContextGenerateEventReport(inout_psContext, m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_GETHEAVYHITTERS_NULL, E_EVENTHANDLER_SEVERITY_MEDIUM, E_EVENTHANDLER_TYPE_NULLARGUMENT);
+    }
+    else
+    {
+        u32NumberOfHeavyHitters = EventHitters_GetHeavyHitters(&inout_psContext->sHitters, out_psHeavyHitters, in_u32MaxNumberOfHeavyHitters);
+    }
+
+    return u32NumberOfHeavyHitters;
+}
+
+/**
+ * @brief Appends a filter rule to the specified context, it takes effect after EventHandler_ContextCompileFilterRules,
+ *        later rules override earlier ones
+ *
+ * @param inout_psContext   Context of the event reporter
+ * @param in_psRule         Filter rule to be added
+ *
+ * @return E_FALSE          The rule is invalid, would drop or only count MEDIUM events, cannot be represented in the lookup
+ *                          tables or there is no room left for it
+ * @return E_TRUE           The rule has been added
+ */
+boolean EventHandler_ContextAddFilterRule(EventHandler_Context_s *inout_psContext, const EventHandler_FilterRule_s *in_psRule)
+{
+    boolean bIsAdded = E_FALSE;
+
+    if (NULL == inout_psContext)
+    {
+        EventHandler_GenerateEventReport(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_CONTEXTADDFILTERRULE_NULL, E_EVENTHANDLER_SEVERITY_MEDIUM, E_EVENTHANDLER_TYPE_NULLARGUMENT);
+    }
+    else if (NULL == in_psRule)
+    {
+        EventHandler_ContextGenerateEventReport(inout_psContext, m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_ADDFILTERRULE_NULL, E_EVENTHANDLER_SEVERITY_MEDIUM, E_EVENTHANDLER_TYPE_NULLARGUMENT);
+    }
+    else if (MODULES_NUMBER_OF_IDS <= (uint32_t) in_psRule->eModuleId)
+    {
+        EventHandler_ContextGenerateEventReportUserData(inout_psContext, m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_ADDFILTERRULE_MODULE, E_EVENTHANDLER_SEVERITY_NORMAL, E_EVENTHANDLER_TYPE_ADDRESSRANGE, (uint32_t) in_psRule->eModuleId);
+    }
+    else if (in_psRule->u32FirstLocation > in_psRule->u32LastLocation)
+    {
+        EventHandler_ContextGenerateEventReportUserData(inout_psContext, m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_ADDFILTERRULE_RANGE, E_EVENTHANDLER_SEVERITY_NORMAL, E_EVENTHANDLER_TYPE_ADDRESSRANGE, in_psRule->u32FirstLocation);
+    }
+    else if ((EVENTHANDLER_FILTER_NUMBER_OF_LOCATIONS <= in_psRule->u32LastLocation) &&
+             ((EVENTHANDLER_FILTER_LAST_LOCATION != in_psRule->u32LastLocation) || (EVENTHANDLER_FILTER_NUMBER_OF_LOCATIONS < in_psRule->u32FirstLocation)))
+    {
+        /* The higher locations share one lookup entry, a rule can only cover them all */
+        EventHandler_ContextGenerateEventReportUserData(inout_psContext, m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_ADDFILTERRULE_LOCATIONS, E_EVENTHANDLER_SEVERITY_NORMAL, E_EVENTHANDLER_TYPE_ADDRESSRANGE, in_psRule->u32LastLocation);
+    }
+    else if ((E_EVENTHANDLER_FILTER_ALLOW != in_psRule->eAction) &&
+             (0U != (in_psRule->u32SeverityMask & (1U << (uint32_t) E_EVENTHANDLER_SEVERITY_MEDIUM))))
+    {
+        /* SRS-004 must not be filtered, NULLARGUMENT events are classified as MEDIUM (SRS-008) */
+        EventHandler_ContextGenerateEventReportUserData(inout_psContext, m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_ADDFILTERRULE_MEDIUM, E_EVENTHANDLER_SEVERITY_NORMAL, E_EVENTHANDLER_TYPE_ADDRESSRANGE, in_psRule->u32SeverityMask);
+    }
+    else if (EVENTHANDLER_FILTER_MAX_NUMBER_OF_RULES <= inout_psContext->u32NumberOfFilterRules)
+    {
+        EventHandler_ContextGenerateEventReportUserData(inout_psContext, m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_ADDFILTERRULE_FULL, E_EVENTHANDLER_SEVERITY_LOW, E_EVENTHANDLER_TYPE_ADDRESSRANGE, inout_psContext->u32NumberOfFilterRules);
+    }
+    else
+    {
+        inout_psContext->asFilterRules[inout_psContext->u32NumberOfFilterRules] = *in_psRule;
+        inout_psContext->u32NumberOfFilterRules++;
+        bIsAdded = E_TRUE;
+    }
+
+    return bIsAdded;
+}
+
+/**
+ * @brief Removes all filter rules of the specified context and lets all events pass
+ *
+ * @param inout_psContext   Context of the event reporter
+ */
+void EventHandler_ContextClearFilterRules(EventHandler_Context_s *inout_psContext)
+{
+    if (NULL != inout_psContext)
+    {
+        inout_psContext->u32NumberOfFilterRules = UNINITIALIZED_COUNTER;
+    }
+
+    EventHandler_ContextCompileFilterRules(inout_psContext);
+
+    return;
+}
+
+/**
+ * @brief Compiles the added filter rules of the specified context into the lookup tables used for every event
+ *
+ * @param inout_psContext   Context of the event reporter
+ */
+void EventHandler_ContextCompileFilterRules(EventHandler_Context_s *inout_psContext)
+{
+    uint32_t u32IterRule = COMMON_STARTING_INDEX_OF_ARRAY;
+    uint32_t u32IterModule = COMMON_STARTING_INDEX_OF_ARRAY;
+    uint32_t u32IterLocation = COMMON_STARTING_INDEX_OF_ARRAY;
+    uint32_t u32FirstLocation = COMMON_STARTING_INDEX_OF_ARRAY;
+    uint32_t u32LastLocation = COMMON_STARTING_INDEX_OF_ARRAY;
+    uint32_t u32ClassMask = 0U;
+    const EventHandler_FilterRule_s *psRule = NULL;
+
+    if (NULL == inout_psContext)
+    {
+        EventHandler_GenerateEventReport(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_EVENTHANDLER_CONTEXTCOMPILEFILTERRULES_NULL, E_EVENTHANDLER_SEVERITY_MEDIUM, E_EVENTHANDLER_TYPE_NULLARGUMENT);
+        return;
+    }
+
+    for (u32IterModule = COMMON_STARTING_INDEX_OF_ARRAY; MODULES_NUMBER_OF_IDS > u32IterModule; u32IterModule++)
+    {
+        for (u32IterLocation = COMMON_STARTING_INDEX_OF_ARRAY; EVENTHANDLER_FILTER_NUMBER_OF_LOCATIONS >= u32IterLocation; u32IterLocation++)
+        {
+            inout_psContext->au32FilterDropMask[u32IterModule][u32IterLocation] = 0U;
+            inout_psContext->au32FilterCountOnlyMask[u32IterModule][u32IterLocation] = 0U;
+        }
+    }
+
+    for (u32IterRule = COMMON_STARTING_INDEX_OF_ARRAY; inout_psContext->u32NumberOfFilterRules > u32IterRule; u32IterRule++)
+    {
+        psRule = &inout_psContext->asFilterRules[u32IterRule];
+        u32ClassMask = EventHandler_GetFilterClassMask(psRule->u32SeverityMask, psRule->u32TypeMask);
+
+        /* Locations above the table size share the last entry, the rules reaching there cover all of them (checked when added) */
+        u32FirstLocation = psRule->u32FirstLocation;
+        if (EVENTHANDLER_FILTER_NUMBER_OF_LOCATIONS < u32FirstLocation)
+        {
+            u32FirstLocation = EVENTHANDLER_FILTER_NUMBER_OF_LOCATIONS;
+        }
+
+        u32LastLocation = psRule->u32LastLocation;
+        if (EVENTHANDLER_FILTER_NUMBER_OF_LOCATIONS < u32LastLocation)
+        {
+            u32LastLocation = EVENTHANDLER_FILTER_NUMBER_OF_LOCATIONS;
+        }
+
+        for (u32IterLocation = u32FirstLocation; u32LastLocation >= u32IterLocation; u32IterLocation++)
+        {
+            inout_psContext->au32FilterDropMask[psRule->eModuleId][u32IterLocation] &= ~u32ClassMask;
+            inout_psContext->au32FilterCountOnlyMask[psRule->eModuleId][u32IterLocation] &= ~u32ClassMask;
+
+            if (E_EVENTHANDLER_FILTER_DROP == psRule->eAction)
+            {
+                inout_psContext->au32FilterDropMask[psRule->eModuleId][u32IterLocation] |= u32ClassMask;
+            }
+            else if (E_EVENTHANDLER_FILTER_COUNTONLY == psRule->eAction)
+            {
+                inout_psContext->au32FilterCountOnlyMask[psRule->eModuleId][u32IterLocation] |= u32ClassMask;
+            }
+            else
+            {
+                ;
+            }
+        }
+    }
+
+    return;
+}
+
+/**
+ * @brief Expands the severity and type masks of a filter rule into the mask of event classes used in the lookup tables
+ *
+ * @param in_u32SeverityMask   Bit (1 << severity) selects the severity
+ * @param in_u32TypeMask       Bit (1 << type) selects the type
+ *
+ * @return                     Bit (severity * EVENTHANDLER_NUMBER_OF_EVENT_TYPES + type) selects the event class
+ */
+static uint32_t EventHandler_GetFilterClassMask(uint32_t in_u32SeverityMask, uint32_t in_u32TypeMask)
+{
+    uint32_t u32IterSeverity = COMMON_STARTING_INDEX_OF_ARRAY;
+    uint32_t u32ClassMask = 0U;
+
+    in_u32TypeMask &= EVENTHANDLER_FILTER_ALL_TYPES;
+
+    for (u32IterSeverity = COMMON_STARTING_INDEX_OF_ARRAY; EVENTHANDLER_NUMBER_OF_EVENT_SEVERITIES > u32IterSeverity; u32IterSeverity++)
+    {
+        if (0U != (in_u32SeverityMask & (1U << u32IterSeverity)))
+        {
+            u32ClassMask |= in_u32TypeMask << (u32IterSeverity * EVENTHANDLER_NUMBER_OF_EVENT_TYPES);
+        }
+    }
+
+    return u32ClassMask;
 }
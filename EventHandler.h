@@ -22,9 +22,42 @@
 
 #include "Common.h"
 #include "Modules.h"
+#include "EventHitters.h"
 
 #define EVENTHANDLER_NUMBER_OF_EVENT_SEVERITIES 3U
 #define EVENTHANDLER_NUMBER_OF_EVENT_TYPES      5U
+#define EVENTHANDLER_NUMBER_OF_RATE_WINDOWS     3U
+
+#define EVENTHANDLER_MAX_NUMBER_OF_SINKS        4U
+/* Events of a batch processed at once, larger batches are split */
+#define EVENTHANDLER_BATCH_MAX_NUMBER_OF_EVENTS 16U
+
+/* Layout of the event report, the time is a native 64-bit float, the rest are 32-bit numbers, the most significant byte first */
+#define EVENTHANDLER_REPORT_TIME_OFFSET         0U
+#define EVENTHANDLER_REPORT_MODULE_OFFSET       8U
+#define EVENTHANDLER_REPORT_LOCATION_OFFSET     12U
+#define EVENTHANDLER_REPORT_SEVERITY_OFFSET     16U
+#define EVENTHANDLER_REPORT_TYPE_OFFSET         20U
+#define EVENTHANDLER_REPORT_DATA_OFFSET         24U
+#define EVENTHANDLER_REPORT_SEQUENCE_OFFSET     28U
+#define EVENTHANDLER_REPORT_CONTEXT_SIZE_OFFSET 32U
+#define EVENTHANDLER_REPORT_SIZE_IN_BYTES       36U
+/* Context data of one event, it follows the report and its size is given at EVENTHANDLER_REPORT_CONTEXT_SIZE_OFFSET */
+#define EVENTHANDLER_CONTEXT_DATA_MAX_SIZE_IN_BYTES 64U
+/* Size given by EventHandler_GetReportSize to a report declaring longer context data, its end cannot be known */
+#define EVENTHANDLER_INVALID_REPORT_SIZE        0U
+/* Reports with the context data of the events processed at once (nested ones included) */
+#define EVENTHANDLER_CONTEXT_ARENA_SIZE_IN_BYTES    512U
+/* Contexts available besides the default one */
+#define EVENTHANDLER_MAX_NUMBER_OF_CONTEXTS     4U
+
+#define EVENTHANDLER_FILTER_MAX_NUMBER_OF_RULES 16U
+/* Locations with their own lookup entry, all higher locations of a module share one entry,
+   so a rule reaching above them has to end at EVENTHANDLER_FILTER_LAST_LOCATION */
+#define EVENTHANDLER_FILTER_NUMBER_OF_LOCATIONS 32U
+#define EVENTHANDLER_FILTER_LAST_LOCATION       0xFFFFFFFFU
+#define EVENTHANDLER_FILTER_ALL_SEVERITIES      ((1U << EVENTHANDLER_NUMBER_OF_EVENT_SEVERITIES) - 1U)
+#define EVENTHANDLER_FILTER_ALL_TYPES           ((1U << EVENTHANDLER_NUMBER_OF_EVENT_TYPES) - 1U)
 
 /* SRS-003 */
 /* Typedef containing all defined event severities */
@@ -46,12 +79,95 @@ typedef enum
     E_EVENTHANDLER_TYPE_UNUPDATEDCONSTANTS = 4U
 } EventHandler_Type_e;
 
+/* Typedef containing all windows, over which the rolling event rates are available */
+typedef enum
+{
+    E_EVENTHANDLER_RATEWINDOW_MINUTE = 0U,  /* 60 buckets of one second */
+    E_EVENTHANDLER_RATEWINDOW_HOUR   = 1U,  /* 60 buckets of one minute */
+    E_EVENTHANDLER_RATEWINDOW_DAY    = 2U   /* 24 buckets of one hour */
+} EventHandler_RateWindow_e;
+
+/* Typedef containing all actions, which a filter rule can apply to the matching events */
+typedef enum
+{
+    E_EVENTHANDLER_FILTER_ALLOW     = 0U,   /* The event is processed as usual */
+    E_EVENTHANDLER_FILTER_DROP      = 1U,   /* The event is neither counted nor reported (not allowed for MEDIUM) */
+    E_EVENTHANDLER_FILTER_COUNTONLY = 2U    /* The event is counted, but not reported (not allowed for MEDIUM) */
+} EventHandler_FilterAction_e;
+
+/* Filter rule matching events of one module within an inclusive range of locations */
+typedef struct
+{
+    Modules_Id_e eModuleId;
+    uint32_t u32FirstLocation;
+    uint32_t u32LastLocation;
+    uint32_t u32SeverityMask;               /* Bit (1 << EventHandler_Severity_e) selects the severity */
+    uint32_t u32TypeMask;                   /* Bit (1 << EventHandler_Type_e) selects the type */
+    EventHandler_FilterAction_e eAction;
+} EventHandler_FilterRule_s;
+
+/* Events generated at once, the arrays are indexed by the event */
+typedef struct
+{
+    const Modules_Id_e *peModuleIds;
+    const uint32_t *pu32LocationsInModule;
+    const EventHandler_Severity_e *peSeverities;
+    const EventHandler_Type_e *peTypes;
+    const uint32_t *pu32AdditionalData;     /* NULL if the events carry no user data */
+    uint32_t u32NumberOfEvents;
+} EventHandler_EventBatch_s;
+
+/* Receiver of the composed event reports, e.g. Comm_SendEventReport, a batch hands over several reports back to back */
+/* The data are valid during the call only, a report with context data is handed over together with them */
+typedef void (*EventHandler_Sink_f)(const uint8_t *in_pu8EventData, uint32_t in_u32DataSize);
+
+/* Clock of the event times in seconds */
+typedef float64_t (*EventHandler_TimeSource_f)(void);
+
+/* Independent event reporter with its own statistics, filters and sinks */
+typedef struct EventHandler_Context_s EventHandler_Context_s;
+
 void EventHandler_GenerateEventReport(Modules_Id_e in_eModuleId, uint32_t in_u32LocationInModule, EventHandler_Severity_e in_eSeverity, EventHandler_Type_e in_eType);
 void EventHandler_GenerateEventReportUserData(Modules_Id_e in_eModuleId, uint32_t in_u32LocationInModule, EventHandler_Severity_e in_eSeverity, EventHandler_Type_e in_eType, uint32_t in_u32AdditionalData);
+void EventHandler_GenerateEventReportContextData(Modules_Id_e in_eModuleId, uint32_t in_u32LocationInModule, EventHandler_Severity_e in_eSeverity, EventHandler_Type_e in_eType, uint32_t in_u32AdditionalData, const uint8_t *in_pu8ContextData, uint32_t in_u32ContextDataSize);
+void EventHandler_GenerateEventReportBatch(const EventHandler_EventBatch_s *in_psBatch);
 void EventHandler_InitializeOnStart(void);
 uint32_t EventHandler_GetEventsCounter(EventHandler_Severity_e in_eSeverity, EventHandler_Type_e in_eType);
 boolean EventHandler_GetStandbyMode(EventHandler_Type_e in_eType);
 boolean EventHandler_GetEnabledReporting(EventHandler_Type_e in_eType);
 void EventHandler_SetEnabledReporting(EventHandler_Type_e in_eType, boolean in_bIsEnabled);
+uint32_t EventHandler_GetDroppedNestedEventsCounter(void);
+uint32_t EventHandler_GetDroppedContextDataCounter(void);
+uint32_t EventHandler_GetNextSequenceNumber(void);
+float64_t EventHandler_GetEventsRate(EventHandler_Severity_e in_eSeverity, EventHandler_Type_e in_eType, EventHandler_RateWindow_e in_eWindow);
+uint32_t EventHandler_GetHeavyHitters(EventHitters_HeavyHitter_s *out_psHeavyHitters, uint32_t in_u32MaxNumberOfHeavyHitters);
+boolean EventHandler_AddFilterRule(const EventHandler_FilterRule_s *in_psRule);
+void EventHandler_ClearFilterRules(void);
+void EventHandler_CompileFilterRules(void);
+uint32_t EventHandler_ReadWord(const uint8_t *in_pu8Data);
+uint32_t EventHandler_GetReportSize(const uint8_t *in_pu8Report);
+
+EventHandler_Context_s *EventHandler_GetDefaultContext(void);
+EventHandler_Context_s *EventHandler_CreateContext(const EventHandler_Sink_f *in_ppfSinks, uint32_t in_u32NumberOfSinks);
+void EventHandler_ContextInitializeOnStart(EventHandler_Context_s *inout_psContext);
+void EventHandler_ContextGenerateEventReport(EventHandler_Context_s *inout_psContext, Modules_Id_e in_eModuleId, uint32_t in_u32LocationInModule, EventHandler_Severity_e in_eSeverity, EventHandler_Type_e in_eType);
+void EventHandler_ContextGenerateEventReportUserData(EventHandler_Context_s *inout_psContext, Modules_Id_e in_eModuleId, uint32_t in_u32LocationInModule, EventHandler_Severity_e in_eSeverity, EventHandler_Type_e in_eType, uint32_t in_u32AdditionalData);
+void EventHandler_ContextGenerateEventReportContextData(EventHandler_Context_s *inout_psContext, Modules_Id_e in_eModuleId, uint32_t in_u32LocationInModule, EventHandler_Severity_e in_eSeverity, EventHandler_Type_e in_eType, uint32_t in_u32AdditionalData, const uint8_t *in_pu8ContextData, uint32_t in_u32ContextDataSize);
+void EventHandler_ContextGenerateEventReportBatch(EventHandler_Context_s *inout_psContext, const EventHandler_EventBatch_s *in_psBatch);
+uint32_t EventHandler_ContextGetEventsCounter(EventHandler_Context_s *inout_psContext, EventHandler_Severity_e in_eSeverity, EventHandler_Type_e in_eType);
+boolean EventHandler_ContextGetStandbyMode(EventHandler_Context_s *inout_psContext, EventHandler_Type_e in_eType);
+boolean EventHandler_ContextGetEnabledReporting(EventHandler_Context_s *inout_psContext, EventHandler_Type_e in_eType);
+void EventHandler_ContextSetEnabledReporting(EventHandler_Context_s *inout_psContext, EventHandler_Type_e in_eType, boolean in_bIsEnabled);
+uint32_t EventHandler_ContextGetDroppedNestedEventsCounter(EventHandler_Context_s *inout_psContext);
+uint32_t EventHandler_ContextGetDroppedContextDataCounter(EventHandler_Context_s *inout_psContext);
+void EventHandler_ContextSetEnabledReset(EventHandler_Context_s *inout_psContext, boolean in_bIsEnabled);
+uint32_t EventHandler_ContextGetSuppressedResetsCounter(EventHandler_Context_s *inout_psContext);
+void EventHandler_ContextSetTimeSource(EventHandler_Context_s *inout_psContext, EventHandler_TimeSource_f in_pfTimeSource);
+uint32_t EventHandler_ContextGetNextSequenceNumber(EventHandler_Context_s *inout_psContext);
+float64_t EventHandler_ContextGetEventsRate(EventHandler_Context_s *inout_psContext, EventHandler_Severity_e in_eSeverity, EventHandler_Type_e in_eType, EventHandler_RateWindow_e in_eWindow);
+uint32_t EventHandler_ContextGetHeavyHitters(EventHandler_Context_s *inout_psContext, EventHitters_HeavyHitter_s *out_psHeavyHitters, uint32_t in_u32MaxNumberOfHeavyHitters);
+boolean EventHandler_ContextAddFilterRule(EventHandler_Context_s *inout_psContext, const EventHandler_FilterRule_s *in_psRule);
+void EventHandler_ContextClearFilterRules(EventHandler_Context_s *inout_psContext);
+void EventHandler_ContextCompileFilterRules(EventHandler_Context_s *inout_psContext);
 
 #endif /* __EVENTHANDLER_H__ */
@@ -0,0 +1,207 @@
+/*
+ ******************************************************************************
+ *                                                                            *
+ *                              Michal Durila                                 *
+ *                                                                            *
+ *                                                                            *
+ *                           ALL RIGHTS RESERVED                              *
+ *                                                                            *
+ ******************************************************************************
+ */
+
+/**
+ *  @file EventHitters.c
+ *  @author Michal Durila
+ *  @brief This module tracks the event sources (module, location) generating most of the events in bounded memory.
+ *
+ * Misra-Gries summary: a tracked source is found through a hash index in O(1). An untracked source
+ * arriving at a full summary decrements all counters, which costs O(N), but can happen at most once
+ * per N + 1 events, so an update costs O(1) amortised. Every decrement may undercount any source
+ * by one, their number is therefore the error bound.
+ *
+ * Copyright 2021 Michal Durila, All rights reserved.
+ */
+
+#include "EventHitters.h"
+
+
+#define EMPTY_SLOT                       0U
+#define INDEX_MASK                       (EVENTHITTERS_INDEX_SIZE - 1U)
+#define HASH_MULTIPLIER_MODULE           0x9E3779B1U
+#define HASH_MULTIPLIER_LOCATION         0x85EBCA6BU
+#define HASH_FOLD_SHIFT                  16U
+#define UNINITIALIZED_COUNTER            0U
+
+static uint32_t EventHitters_FindSlot(const EventHitters_s *in_psHitters, Modules_Id_e in_eModuleId, uint32_t in_u32LocationInModule);
+static void EventHitters_DecrementAll(EventHitters_s *inout_psHitters);
+
+
+/**
+ * @brief Forgets all tracked sources
+ *
+ * @param out_psHitters   Summary to be initialized
+ */
+void EventHitters_Initialize(EventHitters_s *out_psHitters)
+{
+    uint32_t u32IterSlot = COMMON_STARTING_INDEX_OF_ARRAY;
+
+    for (; EVENTHITTERS_INDEX_SIZE > u32IterSlot; u32IterSlot++)
+    {
+        out_psHitters->au8Index[u32IterSlot] = EMPTY_SLOT;
+    }
+
+    out_psHitters->u32NumberOfEntries = UNINITIALIZED_COUNTER;
+    out_psHitters->u32NumberOfDecrements = UNINITIALIZED_COUNTER;
+
+    return;
+}
+
+/**
+ * @brief Counts one event of the source
+ *
+ * @param inout_psHitters           Summary of the event reporter
+ * @param in_eModuleId              ID of a module, in which an event occurred
+ * @param in_u32LocationInModule    Event instance - a specific and unique place in the module
+ */
+void EventHitters_RecordEvent(EventHitters_s *inout_psHitters, Modules_Id_e in_eModuleId, uint32_t in_u32LocationInModule)
+{
+    uint32_t u32Slot = EventHitters_FindSlot(inout_psHitters, in_eModuleId, in_u32LocationInModule);
+    EventHitters_Entry_s *psEntry = NULL;
+
+    if (EMPTY_SLOT != inout_psHitters->au8Index[u32Slot])
+    {
+        inout_psHitters->asEntries[inout_psHitters->au8Index[u32Slot] - 1U].u32Count++;
+    }
+    else if (EVENTHITTERS_NUMBER_OF_ENTRIES > inout_psHitters->u32NumberOfEntries)
+    {
+        psEntry = &inout_psHitters->asEntries[inout_psHitters->u32NumberOfEntries];
+        psEntry->eModuleId = in_eModuleId;
+        psEntry->u32LocationInModule = in_u32LocationInModule;
+        psEntry->u32Count = 1U;
+
+        inout_psHitters->u32NumberOfEntries++;
+        inout_psHitters->au8Index[u32Slot] = (uint8_t) inout_psHitters->u32NumberOfEntries;
+    }
+    else
+    {
+        /* The new source cancels out with one event of every tracked source */
+        EventHitters_DecrementAll(inout_psHitters);
+    }
+
+    return;
+}
+
+/**
+ * @brief Gives the tracked sources ordered from the noisiest one
+ *
+ * @param in_psHitters                   Summary of the event reporter
+ * @param out_psHeavyHitters             Array for the heavy hitters
+ * @param in_u32MaxNumberOfHeavyHitters  Size of the array
+ *
+ * @return                               Number of the heavy hitters written into the array
+ */
+uint32_t EventHitters_GetHeavyHitters(const EventHitters_s *in_psHitters, EventHitters_HeavyHitter_s *out_psHeavyHitters, uint32_t in_u32MaxNumberOfHeavyHitters)
+{
+    uint32_t u32NumberOfHeavyHitters = UNINITIALIZED_COUNTER;
+    uint32_t u32IterEntry = COMMON_STARTING_INDEX_OF_ARRAY;
+    uint32_t u32Position = COMMON_STARTING_INDEX_OF_ARRAY;
+    const EventHitters_Entry_s *psEntry = NULL;
+
+    /* Insertion sort into the output array, keeping the noisiest sources only */
+    for (; in_psHitters->u32NumberOfEntries > u32IterEntry; u32IterEntry++)
+    {
+        psEntry = &in_psHitters->asEntries[u32IterEntry];
+        u32Position = u32NumberOfHeavyHitters;
+
+        while ((COMMON_STARTING_INDEX_OF_ARRAY < u32Position) && (out_psHeavyHitters[u32Position - 1U].u32Count < psEntry->u32Count))
+        {
+            if (in_u32MaxNumberOfHeavyHitters > u32Position)
+            {
+                out_psHeavyHitters[u32Position] = out_psHeavyHitters[u32Position - 1U];
+            }
+
+            u32Position--;
+        }
+
+        if (in_u32MaxNumberOfHeavyHitters > u32Position)
+        {
+            out_psHeavyHitters[u32Position].eModuleId = psEntry->eModuleId;
+            out_psHeavyHitters[u32Position].u32LocationInModule = psEntry->u32LocationInModule;
+            out_psHeavyHitters[u32Position].u32Count = psEntry->u32Count;
+            out_psHeavyHitters[u32Position].u32MaxError = in_psHitters->u32NumberOfDecrements;
+        }
+
+        if (in_u32MaxNumberOfHeavyHitters > u32NumberOfHeavyHitters)
+        {
+            u32NumberOfHeavyHitters++;
+        }
+    }
+
+    return u32NumberOfHeavyHitters;
+}
+
+/**
+ * @brief Finds the slot of the hash index, which holds the source or where the source would be inserted
+ *
+ * @param in_psHitters              Summary of the event reporter
+ * @param in_eModuleId              ID of a module, in which an event occurred
+ * @param in_u32LocationInModule    Event instance - a specific and unique place in the module
+ *
+ * @return                          Slot of the hash index
+ */
+static uint32_t EventHitters_FindSlot(const EventHitters_s *in_psHitters, Modules_Id_e in_eModuleId, uint32_t in_u32LocationInModule)
+{
+    uint32_t u32Hash = ((uint32_t) in_eModuleId * HASH_MULTIPLIER_MODULE) ^ (in_u32LocationInModule * HASH_MULTIPLIER_LOCATION);
+    uint32_t u32Slot = (u32Hash ^ (u32Hash >> HASH_FOLD_SHIFT)) & INDEX_MASK;
+    const EventHitters_Entry_s *psEntry = NULL;
+
+    /* Linear probing, the index always has empty slots as it is larger than the number of entries */
+    while (EMPTY_SLOT != in_psHitters->au8Index[u32Slot])
+    {
+        psEntry = &in_psHitters->asEntries[in_psHitters->au8Index[u32Slot] - 1U];
+
+        if ((in_eModuleId == psEntry->eModuleId) && (in_u32LocationInModule == psEntry->u32LocationInModule))
+        {
+            break;
+        }
+
+        u32Slot = (u32Slot + 1U) & INDEX_MASK;
+    }
+
+    return u32Slot;
+}
+
+/**
+ * @brief Decrements the counters of all tracked sources, forgets the ones reaching zero and rebuilds the hash index
+ *
+ * @param inout_psHitters   Summary of the event reporter
+ */
+static void EventHitters_DecrementAll(EventHitters_s *inout_psHitters)
+{
+    uint32_t u32IterEntry = COMMON_STARTING_INDEX_OF_ARRAY;
+    uint32_t u32IterSlot = COMMON_STARTING_INDEX_OF_ARRAY;
+    uint32_t u32NumberOfEntries = UNINITIALIZED_COUNTER;
+
+    inout_psHitters->u32NumberOfDecrements++;
+
+    for (; EVENTHITTERS_INDEX_SIZE > u32IterSlot; u32IterSlot++)
+    {
+        inout_psHitters->au8Index[u32IterSlot] = EMPTY_SLOT;
+    }
+
+    for (; inout_psHitters->u32NumberOfEntries > u32IterEntry; u32IterEntry++)
+    {
+        inout_psHitters->asEntries[u32IterEntry].u32Count--;
+
+        if (0U != inout_psHitters->asEntries[u32IterEntry].u32Count)
+        {
+            inout_psHitters->asEntries[u32NumberOfEntries] = inout_psHitters->asEntries[u32IterEntry];
+            u32NumberOfEntries++;
+            inout_psHitters->au8Index[EventHitters_FindSlot(inout_psHitters, inout_psHitters->asEntries[u32IterEntry].eModuleId, inout_psHitters->asEntries[u32IterEntry].u32LocationInModule)] = (uint8_t) u32NumberOfEntries;
+        }
+    }
+
+    inout_psHitters->u32NumberOfEntries = u32NumberOfEntries;
+
+    return;
+}
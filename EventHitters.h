@@ -0,0 +1,84 @@
+/*
+ ******************************************************************************
+ *                                                                            *
+ *                              Michal Durila                                 *
+ *                                                                            *
+ *                                                                            *
+ *                           ALL RIGHTS RESERVED                              *
+ *                                                                            *
+ ******************************************************************************
+ */
+
+/**
+ *  @file EventHitters.h
+ *  @author Michal Durila
+ *  @brief This module tracks the event sources (module, location) generating most of the events in bounded memory.
+ *
+ * Copyright 2021 Michal Durila, All rights reserved.
+ */
+
+#ifndef __EVENTHITTERS_H__
+#define __EVENTHITTERS_H__
+
+#include "Common.h"
+#include "Modules.h"
+
+/* Number of the tracked sources, every source with more than 1 / (N + 1) of all events is among them */
+#define EVENTHITTERS_NUMBER_OF_ENTRIES   16U
+/* Size of the hash index of the tracked sources, a power of two greater than EVENTHITTERS_NUMBER_OF_ENTRIES */
+#define EVENTHITTERS_INDEX_SIZE          32U
+
+/* Tracked event source */
+typedef struct
+{
+    Modules_Id_e eModuleId;
+    uint32_t u32LocationInModule;
+    uint32_t u32Count;
+} EventHitters_Entry_s;
+
+/* Heavy hitter as reported - the true number of its events is within <u32Count, u32Count + u32MaxError> */
+typedef struct
+{
+    Modules_Id_e eModuleId;
+    uint32_t u32LocationInModule;
+    uint32_t u32Count;
+    uint32_t u32MaxError;
+} EventHitters_HeavyHitter_s;
+
+/* Misra-Gries summary of the event sources of one event reporter */
+typedef struct
+{
+    EventHitters_Entry_s asEntries[EVENTHITTERS_NUMBER_OF_ENTRIES];
+    uint32_t u32NumberOfEntries;
+    uint8_t au8Index[EVENTHITTERS_INDEX_SIZE];      /* Entry index + 1, 0 marks an empty slot */
+    uint32_t u32NumberOfDecrements;                 /* Upper bound of the undercount of every source */
+} EventHitters_s;
+
+/**
+ * @brief Forgets all tracked sources
+ *
+ * @param out_psHitters   Summary to be initialized
+ */
+void EventHitters_Initialize(EventHitters_s *out_psHitters);
+
+/**
+ * @brief Counts one event of the source
+ *
+ * @param inout_psHitters           Summary of the event reporter
+ * @param in_eModuleId              ID of a module, in which an event occurred
+ * @param in_u32LocationInModule    Event instance - a specific and unique place in the module
+ */
+void EventHitters_RecordEvent(EventHitters_s *inout_psHitters, Modules_Id_e in_eModuleId, uint32_t in_u32LocationInModule);
+
+/**
+ * @brief Gives the tracked sources ordered from the noisiest one
+ *
+ * @param in_psHitters                   Summary of the event reporter
+ * @param out_psHeavyHitters             Array for the heavy hitters
+ * @param in_u32MaxNumberOfHeavyHitters  Size of the array
+ *
+ * @return                               Number of the heavy hitters written into the array
+ */
+uint32_t EventHitters_GetHeavyHitters(const EventHitters_s *in_psHitters, EventHitters_HeavyHitter_s *out_psHeavyHitters, uint32_t in_u32MaxNumberOfHeavyHitters);
+
+#endif /* __EVENTHITTERS_H__ */
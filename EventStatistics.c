@@ -0,0 +1,225 @@
+/*
+ ******************************************************************************
+ *                                                                            *
+ *                              Michal Durila                                 *
+ *                                                                            *
+ *                                                                            *
+ *                           ALL RIGHTS RESERVED                              *
+ *                                                                            *
+ ******************************************************************************
+ */
+
+/**
+ *  @file EventStatistics.c
+ *  @author Michal Durila
+ *  @brief This module keeps rolling-window counts of the events of each severity and type.
+ *
+ * Every window is a ring of buckets with a running sum, so counting an event and querying a rate
+ * cost O(1). The ring is rotated lazily: buckets of the periods elapsed since the last access are
+ * cleared and subtracted from the sum only when the window is touched again.
+ *
+ * Copyright 2021 Michal Durila, All rights reserved.
+ */
+
+#include "EventStatistics.h"
+
+
+#define SECONDS_IN_MINUTE                60.0
+#define INITIAL_PERIOD                   0U
+#define EMPTY_BUCKET                     0U
+
+/* Length of one bucket of each window in seconds */
+static const float64_t m_af64BucketLengthInSeconds[EVENTHANDLER_NUMBER_OF_RATE_WINDOWS] = { 1.0, 60.0, 3600.0 };
+
+/* Number of buckets of each window */
+static const uint32_t m_au32NumberOfBuckets[EVENTHANDLER_NUMBER_OF_RATE_WINDOWS] =
+{
+    EVENTSTATISTICS_NUMBER_OF_SECOND_BUCKETS,
+    EVENTSTATISTICS_NUMBER_OF_MINUTE_BUCKETS,
+    EVENTSTATISTICS_NUMBER_OF_HOUR_BUCKETS
+};
+
+static uint32_t (*EventStatistics_GetBuckets(EventStatistics_s *in_psStatistics, uint32_t in_u32Window))[EVENTSTATISTICS_NUMBER_OF_CLASSES];
+static void EventStatistics_RotateWindow(EventStatistics_s *inout_psStatistics, float64_t in_f64CurrentTimeInSeconds, uint32_t in_u32Window);
+
+
+/**
+ * @brief Clears all windows
+ *
+ * @param out_psStatistics   Statistics to be initialized
+ */
+void EventStatistics_Initialize(EventStatistics_s *out_psStatistics)
+{
+    uint32_t u32IterWindow = COMMON_STARTING_INDEX_OF_ARRAY;
+    uint32_t u32IterBucket = COMMON_STARTING_INDEX_OF_ARRAY;
+    uint32_t u32IterClass = COMMON_STARTING_INDEX_OF_ARRAY;
+    uint32_t (*pau32Buckets)[EVENTSTATISTICS_NUMBER_OF_CLASSES] = NULL;
+
+    for (u32IterWindow = COMMON_STARTING_INDEX_OF_ARRAY; EVENTHANDLER_NUMBER_OF_RATE_WINDOWS > u32IterWindow; u32IterWindow++)
+    {
+        pau32Buckets = EventStatistics_GetBuckets(out_psStatistics, u32IterWindow);
+        out_psStatistics->asWindows[u32IterWindow].u32Period = INITIAL_PERIOD;
+        out_psStatistics->asWindows[u32IterWindow].u32Bucket = COMMON_STARTING_INDEX_OF_ARRAY;
+
+        for (u32IterClass = COMMON_STARTING_INDEX_OF_ARRAY; EVENTSTATISTICS_NUMBER_OF_CLASSES > u32IterClass; u32IterClass++)
+        {
+            out_psStatistics->asWindows[u32IterWindow].au32WindowCount[u32IterClass] = EMPTY_BUCKET;
+
+            for (u32IterBucket = COMMON_STARTING_INDEX_OF_ARRAY; m_au32NumberOfBuckets[u32IterWindow] > u32IterBucket; u32IterBucket++)
+            {
+                pau32Buckets[u32IterBucket][u32IterClass] = EMPTY_BUCKET;
+            }
+        }
+    }
+
+    return;
+}
+
+/**
+ * @brief Counts one event in all windows
+ *
+ * @param inout_psStatistics          Statistics of the event reporter
+ * @param in_f64CurrentTimeInSeconds  Current time from system start in seconds
+ * @param in_eSeverity                Event severity (already validated)
+ * @param in_eType                    Event type (already validated)
+ */
+void EventStatistics_RecordEvent(EventStatistics_s *inout_psStatistics, float64_t in_f64CurrentTimeInSeconds, EventHandler_Severity_e in_eSeverity, EventHandler_Type_e in_eType)
+{
+    uint32_t u32IterWindow = COMMON_STARTING_INDEX_OF_ARRAY;
+    uint32_t u32Class = ((uint32_t) in_eSeverity * EVENTHANDLER_NUMBER_OF_EVENT_TYPES) + (uint32_t) in_eType;
+    EventStatistics_Window_s *psWindow = NULL;
+
+    for (; EVENTHANDLER_NUMBER_OF_RATE_WINDOWS > u32IterWindow; u32IterWindow++)
+    {
+        EventStatistics_RotateWindow(inout_psStatistics, in_f64CurrentTimeInSeconds, u32IterWindow);
+
+        psWindow = &inout_psStatistics->asWindows[u32IterWindow];
+        EventStatistics_GetBuckets(inout_psStatistics, u32IterWindow)[psWindow->u32Bucket][u32Class]++;
+        psWindow->au32WindowCount[u32Class]++;
+    }
+
+    return;
+}
+
+/**
+ * @brief Counts events occurred at the same time in all windows, the windows are rotated once
+ *
+ * @param inout_psStatistics            Statistics of the event reporter
+ * @param in_f64CurrentTimeInSeconds    Current time from system start in seconds
+ * @param in_pu32NumberOfEventsInClass  Number of the events of each class (severity * EVENTHANDLER_NUMBER_OF_EVENT_TYPES + type)
+ */
+void EventStatistics_RecordEvents(EventStatistics_s *inout_psStatistics, float64_t in_f64CurrentTimeInSeconds, const uint32_t *in_pu32NumberOfEventsInClass)
+{
+    uint32_t u32IterWindow = COMMON_STARTING_INDEX_OF_ARRAY;
+    uint32_t u32IterClass = COMMON_STARTING_INDEX_OF_ARRAY;
+    EventStatistics_Window_s *psWindow = NULL;
+    uint32_t *pu32Bucket = NULL;
+
+    for (; EVENTHANDLER_NUMBER_OF_RATE_WINDOWS > u32IterWindow; u32IterWindow++)
+    {
+        EventStatistics_RotateWindow(inout_psStatistics, in_f64CurrentTimeInSeconds, u32IterWindow);
+
+        psWindow = &inout_psStatistics->asWindows[u32IterWindow];
+        pu32Bucket = EventStatistics_GetBuckets(inout_psStatistics, u32IterWindow)[psWindow->u32Bucket];
+
+        for (u32IterClass = COMMON_STARTING_INDEX_OF_ARRAY; EVENTSTATISTICS_NUMBER_OF_CLASSES > u32IterClass; u32IterClass++)
+        {
+            pu32Bucket[u32IterClass] += in_pu32NumberOfEventsInClass[u32IterClass];
+            psWindow->au32WindowCount[u32IterClass] += in_pu32NumberOfEventsInClass[u32IterClass];
+        }
+    }
+
+    return;
+}
+
+/**
+ * @brief Gives the rate of the events within the window, the current (partial) bucket is counted as a whole one
+ *
+ * @param inout_psStatistics          Statistics of the event reporter
+ * @param in_f64CurrentTimeInSeconds  Current time from system start in seconds
+ * @param in_eSeverity                Event severity (already validated)
+ * @param in_eType                    Event type (already validated)
+ * @param in_eWindow                  Window (already validated)
+ *
+ * @return                            Events per minute
+ */
+float64_t EventStatistics_GetRate(EventStatistics_s *inout_psStatistics, float64_t in_f64CurrentTimeInSeconds, EventHandler_Severity_e in_eSeverity, EventHandler_Type_e in_eType, EventHandler_RateWindow_e in_eWindow)
+{
+    uint32_t u32Class = ((uint32_t) in_eSeverity * EVENTHANDLER_NUMBER_OF_EVENT_TYPES) + (uint32_t) in_eType;
+    float64_t f64WindowInMinutes = (m_af64BucketLengthInSeconds[in_eWindow] * (float64_t) m_au32NumberOfBuckets[in_eWindow]) / SECONDS_IN_MINUTE;
+
+    EventStatistics_RotateWindow(inout_psStatistics, in_f64CurrentTimeInSeconds, (uint32_t) in_eWindow);
+
+    return (float64_t) inout_psStatistics->asWindows[in_eWindow].au32WindowCount[u32Class] / f64WindowInMinutes;
+}
+
+/**
+ * @brief Advances the window to the current period, clears the buckets of the elapsed periods and subtracts them from the sum
+ *
+ * @param inout_psStatistics          Statistics of the event reporter
+ * @param in_f64CurrentTimeInSeconds  Current time from system start in seconds
+ * @param in_u32Window                Index of the window
+ */
+static void EventStatistics_RotateWindow(EventStatistics_s *inout_psStatistics, float64_t in_f64CurrentTimeInSeconds, uint32_t in_u32Window)
+{
+    EventStatistics_Window_s *psWindow = &inout_psStatistics->asWindows[in_u32Window];
+    uint32_t (*pau32Buckets)[EVENTSTATISTICS_NUMBER_OF_CLASSES] = EventStatistics_GetBuckets(inout_psStatistics, in_u32Window);
+    uint32_t u32Period = (uint32_t) (in_f64CurrentTimeInSeconds / m_af64BucketLengthInSeconds[in_u32Window]);
+    uint32_t u32ElapsedPeriods = COMMON_STARTING_INDEX_OF_ARRAY;
+    uint32_t u32IterClass = COMMON_STARTING_INDEX_OF_ARRAY;
+
+    /* A time going back (only possible in tests) keeps the current bucket */
+    if (u32Period > psWindow->u32Period)
+    {
+        u32ElapsedPeriods = u32Period - psWindow->u32Period;
+
+        /* Only a whole ring can elapse */
+        if (m_au32NumberOfBuckets[in_u32Window] < u32ElapsedPeriods)
+        {
+            u32ElapsedPeriods = m_au32NumberOfBuckets[in_u32Window];
+        }
+
+        for (; 0U < u32ElapsedPeriods; u32ElapsedPeriods--)
+        {
+            psWindow->u32Bucket = (psWindow->u32Bucket + 1U) % m_au32NumberOfBuckets[in_u32Window];
+
+            for (u32IterClass = COMMON_STARTING_INDEX_OF_ARRAY; EVENTSTATISTICS_NUMBER_OF_CLASSES > u32IterClass; u32IterClass++)
+            {
+                psWindow->au32WindowCount[u32IterClass] -= pau32Buckets[psWindow->u32Bucket][u32IterClass];
+                pau32Buckets[psWindow->u32Bucket][u32IterClass] = EMPTY_BUCKET;
+            }
+        }
+
+        psWindow->u32Period = u32Period;
+    }
+
+    return;
+}
+
+/**
+ * @brief Gives the ring of buckets of the window
+ *
+ * @param in_psStatistics   Statistics of the event reporter
+ * @param in_u32Window      Index of the window
+ *
+ * @return                  Array of the buckets, each holding a counter per event class
+ */
+static uint32_t (*EventStatistics_GetBuckets(EventStatistics_s *in_psStatistics, uint32_t in_u32Window))[EVENTSTATISTICS_NUMBER_OF_CLASSES]
+{
+    uint32_t (*pau32Buckets)[EVENTSTATISTICS_NUMBER_OF_CLASSES] = in_psStatistics->au32SecondBuckets;
+
+    if ((uint32_t) E_EVENTHANDLER_RATEWINDOW_HOUR == in_u32Window)
+    {
+        pau32Buckets = in_psStatistics->au32MinuteBuckets;
+    }
+    else if ((uint32_t) E_EVENTHANDLER_RATEWINDOW_DAY == in_u32Window)
+    {
+        pau32Buckets = in_psStatistics->au32HourBuckets;
+    }
+    else
+    {
+        ;
+    }
+
+    return pau32Buckets;
+}
@@ -0,0 +1,87 @@
+/*
+ ******************************************************************************
+ *                                                                            *
+ *                              Michal Durila                                 *
+ *                                                                            *
+ *                                                                            *
+ *                           ALL RIGHTS RESERVED                              *
+ *                                                                            *
+ ******************************************************************************
+ */
+
+/**
+ *  @file EventStatistics.h
+ *  @author Michal Durila
+ *  @brief This module keeps rolling-window counts of the events of each severity and type.
+ *
+ * Copyright 2021 Michal Durila, All rights reserved.
+ */
+
+#ifndef __EVENTSTATISTICS_H__
+#define __EVENTSTATISTICS_H__
+
+#include "Common.h"
+#include "EventHandler.h"
+
+#define EVENTSTATISTICS_NUMBER_OF_CLASSES        (EVENTHANDLER_NUMBER_OF_EVENT_SEVERITIES * EVENTHANDLER_NUMBER_OF_EVENT_TYPES)
+#define EVENTSTATISTICS_NUMBER_OF_SECOND_BUCKETS 60U
+#define EVENTSTATISTICS_NUMBER_OF_MINUTE_BUCKETS 60U
+#define EVENTSTATISTICS_NUMBER_OF_HOUR_BUCKETS   24U
+
+/* Ring of buckets of one window, the bucket of the current period included */
+typedef struct
+{
+    uint32_t u32Period;                                           /* Number of the current period since the system start */
+    uint32_t u32Bucket;                                           /* Bucket of the current period */
+    uint32_t au32WindowCount[EVENTSTATISTICS_NUMBER_OF_CLASSES];  /* Sum of all buckets of the ring */
+} EventStatistics_Window_s;
+
+/* Rolling-window statistics of one event reporter */
+typedef struct
+{
+    EventStatistics_Window_s asWindows[EVENTHANDLER_NUMBER_OF_RATE_WINDOWS];
+    uint32_t au32SecondBuckets[EVENTSTATISTICS_NUMBER_OF_SECOND_BUCKETS][EVENTSTATISTICS_NUMBER_OF_CLASSES];
+    uint32_t au32MinuteBuckets[EVENTSTATISTICS_NUMBER_OF_MINUTE_BUCKETS][EVENTSTATISTICS_NUMBER_OF_CLASSES];
+    uint32_t au32HourBuckets[EVENTSTATISTICS_NUMBER_OF_HOUR_BUCKETS][EVENTSTATISTICS_NUMBER_OF_CLASSES];
+} EventStatistics_s;
+
+/**
+ * @brief Clears all windows
+ *
+ * @param out_psStatistics   Statistics to be initialized
+ */
+void EventStatistics_Initialize(EventStatistics_s *out_psStatistics);
+
+/**
+ * @brief Counts one event in all windows
+ *
+ * @param inout_psStatistics          Statistics of the event reporter
+ * @param in_f64CurrentTimeInSeconds  Current time from system start in seconds
+ * @param in_eSeverity                Event severity (already validated)
+ * @param in_eType                    Event type (already validated)
+ */
+void EventStatistics_RecordEvent(EventStatistics_s *inout_psStatistics, float64_t in_f64CurrentTimeInSeconds, EventHandler_Severity_e in_eSeverity, EventHandler_Type_e in_eType);
+
+/**
+ * @brief Counts events occurred at the same time in all windows, the windows are rotated once
+ *
+ * @param inout_psStatistics            Statistics of the event reporter
+ * @param in_f64CurrentTimeInSeconds    Current time from system start in seconds
+ * @param in_pu32NumberOfEventsInClass  Number of the events of each class (severity * EVENTHANDLER_NUMBER_OF_EVENT_TYPES + type)
+ */
+void EventStatistics_RecordEvents(EventStatistics_s *inout_psStatistics, float64_t in_f64CurrentTimeInSeconds, const uint32_t *in_pu32NumberOfEventsInClass);
+
+/**
+ * @brief Gives the rate of the events within the window
+ *
+ * @param inout_psStatistics          Statistics of the event reporter
+ * @param in_f64CurrentTimeInSeconds  Current time from system start in seconds
+ * @param in_eSeverity                Event severity (already validated)
+ * @param in_eType                    Event type (already validated)
+ * @param in_eWindow                  Window (already validated)
+ *
+ * @return                            Events per minute
+ */
+float64_t EventStatistics_GetRate(EventStatistics_s *inout_psStatistics, float64_t in_f64CurrentTimeInSeconds, EventHandler_Severity_e in_eSeverity, EventHandler_Type_e in_eType, EventHandler_RateWindow_e in_eWindow);
+
+#endif /* __EVENTSTATISTICS_H__ */
@@ -20,6 +20,9 @@
 #ifndef __MODULES_H__
 #define __MODULES_H__
 
+/* Highest module ID + 1, IDs can be used directly as array indexes */
+#define MODULES_NUMBER_OF_IDS                14U
+
 /* Typedef containing all modules */
 typedef enum
 {
@@ -30,7 +33,12 @@ typedef enum
     E_MODULES_ID_MODULES                 = 5U,
     E_MODULES_ID_EVENTHANDLER            = 6U,
     E_MODULES_ID_SYSTEMRESET             = 7U,
-    E_MODULES_ID_TIMING                  = 8U
+    E_MODULES_ID_TIMING                  = 8U,
+    E_MODULES_ID_EVENTSTATISTICS         = 9U,
+    E_MODULES_ID_EVENTHITTERS            = 10U,
+    E_MODULES_ID_SINKWORKER              = 11U,
+    E_MODULES_ID_TRACEEXPORT             = 12U,
+    E_MODULES_ID_SIMULATOR               = 13U
 } Modules_Id_e;
 
 #endif /* __MODULES_H__ */
@@ -22,9 +22,6 @@
 #include "EventHandler.h"
 
 
-#define NVM_ADDRESS_LOW_LIM     0x00001000
-#define NVM_ADDRESS_HIGH_LIM    0x00200000
-
 /* Module ID assignment */
 static const Modules_Id_e m_eModuleId = E_MODULES_ID_NVMMEM;
 
@@ -33,7 +30,11 @@ typedef enum
 {
     E_EVENT_INSTANCE_NVMMEM_WRITE_ADDRESS    = 0U,
     E_EVENT_INSTANCE_NVMMEM_WRITE_NULL       = 1U,
-    E_EVENT_INSTANCE_NVMMEM_WRITE_DATASIZE   = 2U
+    E_EVENT_INSTANCE_NVMMEM_WRITE_DATASIZE   = 2U,
+    E_EVENT_INSTANCE_NVMMEM_READ_ADDRESS     = 3U,
+    E_EVENT_INSTANCE_NVMMEM_READ_NULL        = 4U,
+    E_EVENT_INSTANCE_NVMMEM_READ_DATASIZE    = 5U,
+    E_EVENT_INSTANCE_NVMMEM_ERASE_ADDRESS    = 6U
 } EventInstance_e;
 
 
@@ -47,7 +48,7 @@ typedef enum
 void NvmMem_Write(uint32_t in_u32Address, const uint8_t *in_pu8Data, uint32_t in_u32DataSize)
 {
     /* Address range check */
-    if ((NVM_ADDRESS_LOW_LIM > in_u32Address) || (NVM_ADDRESS_HIGH_LIM < in_u32Address))
+    if ((NVMMEM_ADDRESS_LOW_LIM > in_u32Address) || (NVMMEM_ADDRESS_HIGH_LIM < in_u32Address))
     {
         EventHandler_GenerateEventReportUserData(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_NVMMEM_WRITE_ADDRESS, E_EVENTHANDLER_SEVERITY_NORMAL, E_EVENTHANDLER_TYPE_ADDRESSRANGE, in_u32Address);
         return;
@@ -71,3 +72,57 @@ void NvmMem_Write(uint32_t in_u32Address, const uint8_t *in_pu8Data, uint32_t in
 
     return;
 }
+
+/**
+ * @brief Reads data from the non-volatile memory at the specific address
+ *
+ * @param in_u32Address     Source memory address
+ * @param out_pu8Data       Buffer for the read data
+ * @param in_u32DataSize    Size of the data in bytes
+ */
+void NvmMem_Read(uint32_t in_u32Address, uint8_t *out_pu8Data, uint32_t in_u32DataSize)
+{
+    /* Address range check */
+    if ((NVMMEM_ADDRESS_LOW_LIM > in_u32Address) || (NVMMEM_ADDRESS_HIGH_LIM < in_u32Address))
+    {
+        EventHandler_GenerateEventReportUserData(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_NVMMEM_READ_ADDRESS, E_EVENTHANDLER_SEVERITY_NORMAL, E_EVENTHANDLER_TYPE_ADDRESSRANGE, in_u32Address);
+        return;
+    }
+
+    /* Buffer validity check */
+    if (NULL == out_pu8Data)
+    {
+        EventHandler_GenerateEventReport(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_NVMMEM_READ_NULL, E_EVENTHANDLER_SEVERITY_MEDIUM, E_EVENTHANDLER_TYPE_NULLARGUMENT);
+        return;
+    }
+
+    /* Minimum data length check */
+    if (0U == in_u32DataSize)
+    {
+        EventHandler_GenerateEventReport(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_NVMMEM_READ_DATASIZE, E_EVENTHANDLER_SEVERITY_LOW, E_EVENTHANDLER_TYPE_MINDATALENGTH);
+        return;
+    }
+
+    /* ... MEMORY READING IMPLEMENTATION ... */
+
+    return;
+}
+
+/**
+ * @brief Erases the whole sector of the non-volatile memory, all its bytes read as NVMMEM_ERASED_BYTE afterwards
+ *
+ * @param in_u32Address     Start address of the sector
+ */
+void NvmMem_EraseSector(uint32_t in_u32Address)
+{
+    /* Address range and alignment check */
+    if ((NVMMEM_ADDRESS_LOW_LIM > in_u32Address) || (NVMMEM_ADDRESS_HIGH_LIM <= in_u32Address) || (0U != (in_u32Address % NVMMEM_SECTOR_SIZE_IN_BYTES)))
+    {
+        EventHandler_GenerateEventReportUserData(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_NVMMEM_ERASE_ADDRESS, E_EVENTHANDLER_SEVERITY_NORMAL, E_EVENTHANDLER_TYPE_ADDRESSRANGE, in_u32Address);
+        return;
+    }
+
+    /* ... MEMORY ERASING IMPLEMENTATION ... */
+
+    return;
+}
@@ -22,6 +22,13 @@
 
 #include "Common.h"
 
+#define NVMMEM_ADDRESS_LOW_LIM          0x00001000U
+#define NVMMEM_ADDRESS_HIGH_LIM         0x00200000U
+#define NVMMEM_SECTOR_SIZE_IN_BYTES     0x00001000U
+#define NVMMEM_ERASED_BYTE              0xFFU
+
 void NvmMem_Write(uint32_t in_u32Address, const uint8_t *in_pu8Data, uint32_t in_u32DataSize);
+void NvmMem_Read(uint32_t in_u32Address, uint8_t *out_pu8Data, uint32_t in_u32DataSize);
+void NvmMem_EraseSector(uint32_t in_u32Address);
 
 #endif /* __NVMMEM_H__ */
@@ -0,0 +1,537 @@
+/*
+ ******************************************************************************
+ *                                                                            *
+ *                              Michal Durila                                 *
+ *                                                                            *
+ *                                                                            *
+ *                           ALL RIGHTS RESERVED                              *
+ *                                                                            *
+ ******************************************************************************
+ */
+
+/**
+ *  @file Simulator.c
+ *  @author Michal Durila
+ *  @brief This module replays event workloads in virtual time to size the links and the memory fed by the reports.
+ *
+ * The events are generated in an own context of the event reporter, whose sink only counts the reports.
+ * The reset of the context is disabled, a MEDIUM event is counted and the context goes on as after it.
+ * The context reads its time from the virtual clock of the simulation, so the Standby mode logic runs
+ * exactly as on the target, while days of virtual time take seconds and the time of the system and
+ * of the other contexts is left alone. The counters are kept per virtual second and minute only, so
+ * the memory used does not depend on the length of the workload. A sink writing to the target, as
+ * the event log of Storage, is refused.
+ *
+ * Copyright 2021 Michal Durila, All rights reserved.
+ */
+
+#include "Simulator.h"
+#include "Timing.h"
+#include "Storage.h"
+
+#if defined(EVENTHANDLER_USE_SINK_WORKERS)
+#include "SinkWorker.h"
+#endif
+
+
+#define UNINITIALIZED_COUNTER            0U
+#define SECONDS_IN_MINUTE                60U
+#define RANDOM_MULTIPLIER                1664525U
+#define RANDOM_INCREMENT                 1013904223U
+#define RANDOM_RANGE                     4294967296.0
+
+/* Module ID assignment */
+static const Modules_Id_e m_eModuleId = E_MODULES_ID_SIMULATOR;
+
+/* Typedef containing all defined event instances in this module */
+typedef enum
+{
+    E_EVENT_INSTANCE_SIMULATOR_REPLAYEVENTS_NULL         = 0U,
+    E_EVENT_INSTANCE_SIMULATOR_RUNWORKLOAD_NULL          = 1U,
+    E_EVENT_INSTANCE_SIMULATOR_RUNWORKLOAD_TIMES         = 2U,
+    E_EVENT_INSTANCE_SIMULATOR_RUNWORKLOAD_TYPES         = 3U,
+    E_EVENT_INSTANCE_SIMULATOR_STOP_NULL                 = 4U,
+    E_EVENT_INSTANCE_SIMULATOR_GENERATEEVENT_TIME        = 5U,
+    E_EVENT_INSTANCE_SIMULATOR_START_SINK                = 6U,
+    E_EVENT_INSTANCE_SIMULATOR_COUNTREPORTS_CONTEXTSIZE  = 7U
+} EventInstance_e;
+
+/* Context of the simulated events, created once and cleared by each start */
+static EventHandler_Context_s *m_psContext = NULL;
+static boolean m_bIsRunning = E_FALSE;
+static Simulator_MinuteReport_f m_pfMinuteReport;
+static EventHandler_Sink_f m_pfSink;
+static float64_t m_f64CurrentTime;
+static uint32_t m_u32RandomState;
+
+/* Counters of the current virtual second and minute */
+static uint32_t m_u32CurrentSecond;
+static uint32_t m_au32EventsInSecond[EVENTHANDLER_NUMBER_OF_EVENT_TYPES];
+static uint32_t m_u32ReportsInSecond;
+static uint32_t m_u32CurrentMinute;
+static uint32_t m_u32SinkBytesInMinute;
+
+static Simulator_Results_s m_sResults;
+
+static void Simulator_GenerateEvent(const Simulator_Event_s *in_psEvent);
+static float64_t Simulator_GetTime(void);
+static void Simulator_AdvanceTime(float64_t in_f64TimeInSeconds);
+static void Simulator_CloseSecond(void);
+static void Simulator_CloseMinute(void);
+static void Simulator_CountReports(const uint8_t *in_pu8EventData, uint32_t in_u32DataSize);
+static EventHandler_Type_e Simulator_DrawType(uint32_t in_u32TypeMask, uint32_t in_u32NumberOfTypes);
+static uint32_t Simulator_DrawNumber(void);
+
+
+/**
+ * @brief Starts a simulation at the virtual time 0 with the reporting state cleared
+ *
+ * @param in_pfMinuteReport   Receiver of the bytes per virtual minute, may be NULL
+ * @param in_pfSink           Sink getting the reports as well, e.g. TraceExport_ExportReport, may be NULL;
+ *                            Storage_StoreEventReport is refused, the simulated reports would fill the event log of the target
+ *
+ * @return E_FALSE            The simulation cannot be started (no context left or the sink refused)
+ * @return E_TRUE             The simulation is started
+ */
+boolean Simulator_Start(Simulator_MinuteReport_f in_pfMinuteReport, EventHandler_Sink_f in_pfSink)
+{
+    const EventHandler_Sink_f apfSinks[] = {Simulator_CountReports};
+    uint32_t u32IterType = COMMON_STARTING_INDEX_OF_ARRAY;
+    boolean bIsSinkOfTarget = (Storage_StoreEventReport == in_pfSink) ? E_TRUE : E_FALSE;
+
+#if defined(EVENTHANDLER_USE_SINK_WORKERS)
+    if (SinkWorker_SubmitReport == in_pfSink)
+    {
+        bIsSinkOfTarget = E_TRUE;
+    }
+#endif
+
+    if (E_TRUE == bIsSinkOfTarget)
+    {
+        EventHandler_GenerateEventReport(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_SIMULATOR_START_SINK, E_EVENTHANDLER_SEVERITY_LOW, E_EVENTHANDLER_TYPE_ADDRESSRANGE);
+        return E_FALSE;
+    }
+
+    if (NULL == m_psContext)
+    {
+        m_psContext = EventHandler_CreateContext(apfSinks, sizeof(apfSinks) / sizeof(apfSinks[COMMON_STARTING_INDEX_OF_ARRAY]));
+
+        if (NULL == m_psContext)
+        {
+            return E_FALSE;
+        }
+
+        EventHandler_ContextSetEnabledReset(m_psContext, E_FALSE);
+        EventHandler_ContextSetTimeSource(m_psContext, Simulator_GetTime);
+    }
+
+    EventHandler_ContextInitializeOnStart(m_psContext);
+
+    m_pfMinuteReport = in_pfMinuteReport;
+    m_pfSink = in_pfSink;
+    m_f64CurrentTime = TIMING_INITIAL_TIME;
+    m_u32CurrentSecond = UNINITIALIZED_COUNTER;
+    m_u32ReportsInSecond = UNINITIALIZED_COUNTER;
+    m_u32CurrentMinute = UNINITIALIZED_COUNTER;
+    m_u32SinkBytesInMinute = UNINITIALIZED_COUNTER;
+
+    for (; EVENTHANDLER_NUMBER_OF_EVENT_TYPES > u32IterType; u32IterType++)
+    {
+        m_au32EventsInSecond[u32IterType] = UNINITIALIZED_COUNTER;
+        m_sResults.au32GeneratedEvents[u32IterType] = UNINITIALIZED_COUNTER;
+        m_sResults.au32ForwardedEvents[u32IterType] = UNINITIALIZED_COUNTER;
+        m_sResults.au32SuppressedEvents[u32IterType] = UNINITIALIZED_COUNTER;
+        m_sResults.au32PeakEventsPerSecond[u32IterType] = UNINITIALIZED_COUNTER;
+    }
+
+    m_sResults.u32PeakReportsPerSecond = UNINITIALIZED_COUNTER;
+    m_sResults.u32NumberOfMinutes = UNINITIALIZED_COUNTER;
+    m_sResults.u32PeakSinkBytesPerMinute = UNINITIALIZED_COUNTER;
+    m_sResults.u64SinkBytes = UNINITIALIZED_COUNTER;
+    m_sResults.u32Resets = UNINITIALIZED_COUNTER;
+
+    m_bIsRunning = E_TRUE;
+
+    return E_TRUE;
+}
+
+/**
+ * @brief Replays the recorded events, a long recording can be replayed in parts
+ *
+ * @param in_psEvents           Events ordered by their time
+ * @param in_u32NumberOfEvents  Number of the events
+ */
+void Simulator_ReplayEvents(const Simulator_Event_s *in_psEvents, uint32_t in_u32NumberOfEvents)
+{
+    uint32_t u32IterEvent = COMMON_STARTING_INDEX_OF_ARRAY;
+
+    if (NULL == in_psEvents)
+    {
+        EventHandler_GenerateEventReport(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_SIMULATOR_REPLAYEVENTS_NULL, E_EVENTHANDLER_SEVERITY_MEDIUM, E_EVENTHANDLER_TYPE_NULLARGUMENT);
+        return;
+    }
+
+    if (E_FALSE == m_bIsRunning)
+    {
+        return;
+    }
+
+    for (; in_u32NumberOfEvents > u32IterEvent; u32IterEvent++)
+    {
+        Simulator_GenerateEvent(&in_psEvents[u32IterEvent]);
+    }
+
+    return;
+}
+
+/**
+ * @brief Generates the synthetic workload and replays it, starting at the virtual time reached so far
+ *
+ * @param in_psWorkload   Parameters of the workload
+ */
+void Simulator_RunWorkload(const Simulator_Workload_s *in_psWorkload)
+{
+    Simulator_Event_s sEvent;
+    float64_t f64EndTime = TIMING_INITIAL_TIME;
+    float64_t f64NextBackgroundTime = TIMING_INITIAL_TIME;
+    float64_t f64BurstStartTime = TIMING_INITIAL_TIME;
+    float64_t f64NextBurstTime = TIMING_INITIAL_TIME;
+    uint32_t u32EventInBurst = COMMON_STARTING_INDEX_OF_ARRAY;
+    uint32_t u32NumberOfTypes = UNINITIALIZED_COUNTER;
+    uint32_t u32IterType = COMMON_STARTING_INDEX_OF_ARRAY;
+    boolean bIsBackground = E_FALSE;
+    boolean bIsBurst = E_FALSE;
+
+    if (NULL == in_psWorkload)
+    {
+        EventHandler_GenerateEventReport(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_SIMULATOR_RUNWORKLOAD_NULL, E_EVENTHANDLER_SEVERITY_MEDIUM, E_EVENTHANDLER_TYPE_NULLARGUMENT);
+        return;
+    }
+
+    if ((TIMING_INITIAL_TIME > in_psWorkload->f64DurationInSeconds) || (TIMING_INITIAL_TIME > in_psWorkload->f64MeanIntervalInSeconds) ||
+        (TIMING_INITIAL_TIME > in_psWorkload->f64BurstPeriodInSeconds) || (TIMING_INITIAL_TIME > in_psWorkload->f64BurstIntervalInSeconds))
+    {
+        EventHandler_GenerateEventReport(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_SIMULATOR_RUNWORKLOAD_TIMES, E_EVENTHANDLER_SEVERITY_LOW, E_EVENTHANDLER_TYPE_ADDRESSRANGE);
+        return;
+    }
+
+    for (; EVENTHANDLER_NUMBER_OF_EVENT_TYPES > u32IterType; u32IterType++)
+    {
+        if (0U != (in_psWorkload->u32TypeMask & (1U << u32IterType)))
+        {
+            u32NumberOfTypes++;
+        }
+    }
+
+    if (UNINITIALIZED_COUNTER == u32NumberOfTypes)
+    {
+        EventHandler_GenerateEventReportUserData(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_SIMULATOR_RUNWORKLOAD_TYPES, E_EVENTHANDLER_SEVERITY_LOW, E_EVENTHANDLER_TYPE_ADDRESSRANGE, in_psWorkload->u32TypeMask);
+        return;
+    }
+
+    if (E_FALSE == m_bIsRunning)
+    {
+        return;
+    }
+
+    m_u32RandomState = in_psWorkload->u32Seed;
+    f64EndTime = m_f64CurrentTime + in_psWorkload->f64DurationInSeconds;
+    bIsBackground = (TIMING_INITIAL_TIME < in_psWorkload->f64MeanIntervalInSeconds) ? E_TRUE : E_FALSE;
+    bIsBurst = ((TIMING_INITIAL_TIME < in_psWorkload->f64BurstPeriodInSeconds) && (0U != in_psWorkload->u32EventsPerBurst)) ? E_TRUE : E_FALSE;
+    f64BurstStartTime = m_f64CurrentTime;
+    f64NextBurstTime = m_f64CurrentTime;
+
+    sEvent.eModuleId = in_psWorkload->eModuleId;
+    sEvent.eSeverity = in_psWorkload->eSeverity;
+    sEvent.u32AdditionalData = UNINITIALIZED_COUNTER;
+
+    if (E_TRUE == bIsBackground)
+    {
+        f64NextBackgroundTime = m_f64CurrentTime + (2.0 * in_psWorkload->f64MeanIntervalInSeconds * (1.0 - ((float64_t) Simulator_DrawNumber() / RANDOM_RANGE)));
+    }
+
+    while ((E_TRUE == bIsBackground) || (E_TRUE == bIsBurst))
+    {
+        /* The background and the bursts are merged by their time */
+        if ((E_TRUE == bIsBurst) && ((E_FALSE == bIsBackground) || (f64NextBurstTime <= f64NextBackgroundTime)))
+        {
+            if (f64EndTime < f64NextBurstTime)
+            {
+                bIsBurst = E_FALSE;
+                continue;
+            }
+
+            sEvent.f64TimeInSeconds = f64NextBurstTime;
+            u32EventInBurst++;
+
+            if (in_psWorkload->u32EventsPerBurst <= u32EventInBurst)
+            {
+                /* A burst longer than the period delays the next one */
+                u32EventInBurst = COMMON_STARTING_INDEX_OF_ARRAY;
+                f64BurstStartTime += in_psWorkload->f64BurstPeriodInSeconds;
+
+                if (f64BurstStartTime < f64NextBurstTime)
+                {
+                    f64BurstStartTime = f64NextBurstTime;
+                }
+            }
+
+            f64NextBurstTime = f64BurstStartTime + ((float64_t) u32EventInBurst * in_psWorkload->f64BurstIntervalInSeconds);
+        }
+        else
+        {
+            if (f64EndTime < f64NextBackgroundTime)
+            {
+                bIsBackground = E_FALSE;
+                continue;
+            }
+
+            sEvent.f64TimeInSeconds = f64NextBackgroundTime;
+            f64NextBackgroundTime += 2.0 * in_psWorkload->f64MeanIntervalInSeconds * (1.0 - ((float64_t) Simulator_DrawNumber() / RANDOM_RANGE));
+        }
+
+        sEvent.u32LocationInModule = Simulator_DrawNumber() % EVENTHANDLER_FILTER_NUMBER_OF_LOCATIONS;
+        sEvent.eType = Simulator_DrawType(in_psWorkload->u32TypeMask, u32NumberOfTypes);
+        Simulator_GenerateEvent(&sEvent);
+        sEvent.u32AdditionalData++;
+    }
+
+    Simulator_AdvanceTime(f64EndTime);
+
+    return;
+}
+
+/**
+ * @brief Finishes the simulation
+ *
+ * @param out_psResults   Outcome of the simulation
+ */
+void Simulator_Stop(Simulator_Results_s *out_psResults)
+{
+    uint32_t u32IterType = COMMON_STARTING_INDEX_OF_ARRAY;
+
+    if (NULL == out_psResults)
+    {
+        EventHandler_GenerateEventReport(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_SIMULATOR_STOP_NULL, E_EVENTHANDLER_SEVERITY_MEDIUM, E_EVENTHANDLER_TYPE_NULLARGUMENT);
+        return;
+    }
+
+    if (E_TRUE == m_bIsRunning)
+    {
+        Simulator_CloseSecond();
+        Simulator_CloseMinute();
+
+        for (; EVENTHANDLER_NUMBER_OF_EVENT_TYPES > u32IterType; u32IterType++)
+        {
+            if (m_sResults.au32GeneratedEvents[u32IterType] > m_sResults.au32ForwardedEvents[u32IterType])
+            {
+                m_sResults.au32SuppressedEvents[u32IterType] = m_sResults.au32GeneratedEvents[u32IterType] - m_sResults.au32ForwardedEvents[u32IterType];
+            }
+        }
+
+        m_sResults.u32Resets = EventHandler_ContextGetSuppressedResetsCounter(m_psContext);
+        m_bIsRunning = E_FALSE;
+    }
+
+    *out_psResults = m_sResults;
+
+    return;
+}
+
+/**
+ * @brief Moves the virtual time to the event and generates it in the context of the simulation
+ *
+ * @param in_psEvent   Event to be generated
+ */
+static void Simulator_GenerateEvent(const Simulator_Event_s *in_psEvent)
+{
+    if (m_f64CurrentTime > in_psEvent->f64TimeInSeconds)
+    {
+        /* The time cannot go back, the event is skipped */
+        EventHandler_GenerateEventReportUserData(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_SIMULATOR_GENERATEEVENT_TIME, E_EVENTHANDLER_SEVERITY_LOW, E_EVENTHANDLER_TYPE_ADDRESSRANGE, in_psEvent->u32LocationInModule);
+        return;
+    }
+
+    Simulator_AdvanceTime(in_psEvent->f64TimeInSeconds);
+
+    if (EVENTHANDLER_NUMBER_OF_EVENT_TYPES > in_psEvent->eType)
+    {
+        m_sResults.au32GeneratedEvents[in_psEvent->eType]++;
+        m_au32EventsInSecond[in_psEvent->eType]++;
+    }
+
+    EventHandler_ContextGenerateEventReportUserData(m_psContext, in_psEvent->eModuleId, in_psEvent->u32LocationInModule, in_psEvent->eSeverity, in_psEvent->eType, in_psEvent->u32AdditionalData);
+
+    return;
+}
+
+/**
+ * @brief Gives the virtual time, it is the time source of the context of the simulation
+ *
+ * @return   Virtual time in seconds
+ */
+static float64_t Simulator_GetTime(void)
+{
+    return m_f64CurrentTime;
+}
+
+/**
+ * @brief Closes the virtual seconds and minutes passed before the time
+ *
+ * @param in_f64TimeInSeconds   New virtual time, not earlier than the current one
+ */
+static void Simulator_AdvanceTime(float64_t in_f64TimeInSeconds)
+{
+    uint32_t u32Second = (uint32_t) in_f64TimeInSeconds;
+
+    m_f64CurrentTime = in_f64TimeInSeconds;
+
+    if (m_u32CurrentSecond != u32Second)
+    {
+        Simulator_CloseSecond();
+        m_u32CurrentSecond = u32Second;
+    }
+
+    while (m_u32CurrentMinute < (u32Second / SECONDS_IN_MINUTE))
+    {
+        Simulator_CloseMinute();
+        m_u32CurrentMinute++;
+    }
+
+    return;
+}
+
+/**
+ * @brief Takes the counters of the current virtual second into the peaks and clears them
+ */
+static void Simulator_CloseSecond(void)
+{
+    uint32_t u32IterType = COMMON_STARTING_INDEX_OF_ARRAY;
+
+    for (; EVENTHANDLER_NUMBER_OF_EVENT_TYPES > u32IterType; u32IterType++)
+    {
+        if (m_sResults.au32PeakEventsPerSecond[u32IterType] < m_au32EventsInSecond[u32IterType])
+        {
+            m_sResults.au32PeakEventsPerSecond[u32IterType] = m_au32EventsInSecond[u32IterType];
+        }
+
+        m_au32EventsInSecond[u32IterType] = UNINITIALIZED_COUNTER;
+    }
+
+    if (m_sResults.u32PeakReportsPerSecond < m_u32ReportsInSecond)
+    {
+        m_sResults.u32PeakReportsPerSecond = m_u32ReportsInSecond;
+    }
+
+    m_u32ReportsInSecond = UNINITIALIZED_COUNTER;
+
+    return;
+}
+
+/**
+ * @brief Hands the report bytes of the current virtual minute over and takes them into the results
+ */
+static void Simulator_CloseMinute(void)
+{
+    if (NULL != m_pfMinuteReport)
+    {
+        m_pfMinuteReport(m_u32CurrentMinute, m_u32SinkBytesInMinute);
+    }
+
+    if (m_sResults.u32PeakSinkBytesPerMinute < m_u32SinkBytesInMinute)
+    {
+        m_sResults.u32PeakSinkBytesPerMinute = m_u32SinkBytesInMinute;
+    }
+
+    m_sResults.u64SinkBytes += m_u32SinkBytesInMinute;
+    m_sResults.u32NumberOfMinutes = m_u32CurrentMinute + 1U;
+    m_u32SinkBytesInMinute = UNINITIALIZED_COUNTER;
+
+    return;
+}
+
+/**
+ * @brief Sink of the context of the simulation, counts the reports by their type and passes them on,
+ *        the counting stops at a report declaring too long context data
+ *
+ * @param in_pu8EventData   Event report data array, reports back to back
+ * @param in_u32DataSize    Size of event report data in bytes
+ */
+static void Simulator_CountReports(const uint8_t *in_pu8EventData, uint32_t in_u32DataSize)
+{
+    uint32_t u32IterBytes = COMMON_STARTING_INDEX_OF_ARRAY;
+    uint32_t u32Type = UNINITIALIZED_COUNTER;
+    uint32_t u32ReportSize = EVENTHANDLER_REPORT_SIZE_IN_BYTES;
+
+    while ((in_u32DataSize > u32IterBytes) && ((in_u32DataSize - u32IterBytes) >= EVENTHANDLER_REPORT_SIZE_IN_BYTES))
+    {
+        u32ReportSize = EventHandler_GetReportSize(&in_pu8EventData[u32IterBytes]);
+
+        if (EVENTHANDLER_INVALID_REPORT_SIZE == u32ReportSize)
+        {
+            /* The report boundaries are lost, the rest of the data is not counted */
+            EventHandler_GenerateEventReportUserData(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_SIMULATOR_COUNTREPORTS_CONTEXTSIZE, E_EVENTHANDLER_SEVERITY_LOW, E_EVENTHANDLER_TYPE_ADDRESSRANGE, EventHandler_ReadWord(&in_pu8EventData[u32IterBytes + EVENTHANDLER_REPORT_CONTEXT_SIZE_OFFSET]));
+            break;
+        }
+
+        u32Type = EventHandler_ReadWord(&in_pu8EventData[u32IterBytes + EVENTHANDLER_REPORT_TYPE_OFFSET]);
+
+        if (EVENTHANDLER_NUMBER_OF_EVENT_TYPES > u32Type)
+        {
+            m_sResults.au32ForwardedEvents[u32Type]++;
+        }
+
+        m_u32ReportsInSecond++;
+        u32IterBytes += u32ReportSize;
+    }
+
+    m_u32SinkBytesInMinute += in_u32DataSize;
+
+    if (NULL != m_pfSink)
+    {
+        m_pfSink(in_pu8EventData, in_u32DataSize);
+    }
+
+    return;
+}
+
+/**
+ * @brief Draws one of the types in the mask
+ *
+ * @param in_u32TypeMask        Types to draw from, bit (1 << type)
+ * @param in_u32NumberOfTypes   Number of the types in the mask
+ *
+ * @return                      Drawn type
+ */
+static EventHandler_Type_e Simulator_DrawType(uint32_t in_u32TypeMask, uint32_t in_u32NumberOfTypes)
+{
+    uint32_t u32IterType = COMMON_STARTING_INDEX_OF_ARRAY;
+    uint32_t u32Drawn = Simulator_DrawNumber() % in_u32NumberOfTypes;
+
+    for (; EVENTHANDLER_NUMBER_OF_EVENT_TYPES > u32IterType; u32IterType++)
+    {
+        if (0U != (in_u32TypeMask & (1U << u32IterType)))
+        {
+            if (0U == u32Drawn)
+            {
+                break;
+            }
+
+            u32Drawn--;
+        }
+    }
+
+    return (EventHandler_Type_e) u32IterType;
+}
+
+/**
+ * @brief Draws a pseudo-random number, the same seed gives the same workload
+ *
+ * @return   Number
+ */
+static uint32_t Simulator_DrawNumber(void)
+{
+    m_u32RandomState = (m_u32RandomState * RANDOM_MULTIPLIER) + RANDOM_INCREMENT;
+
+    return m_u32RandomState;
+}
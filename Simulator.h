@@ -0,0 +1,103 @@
+/*
+ ******************************************************************************
+ *                                                                            *
+ *                              Michal Durila                                 *
+ *                                                                            *
+ *                                                                            *
+ *                           ALL RIGHTS RESERVED                              *
+ *                                                                            *
+ ******************************************************************************
+ */
+
+/**
+ *  @file Simulator.h
+ *  @author Michal Durila
+ *  @brief This module replays event workloads in virtual time to size the links and the memory fed by the reports.
+ *
+ * Copyright 2021 Michal Durila, All rights reserved.
+ */
+
+#ifndef __SIMULATOR_H__
+#define __SIMULATOR_H__
+
+#include "Common.h"
+#include "EventHandler.h"
+#include "Modules.h"
+
+/* One event of a recorded workload */
+typedef struct
+{
+    float64_t f64TimeInSeconds;
+    Modules_Id_e eModuleId;
+    uint32_t u32LocationInModule;
+    EventHandler_Severity_e eSeverity;
+    EventHandler_Type_e eType;
+    uint32_t u32AdditionalData;
+} Simulator_Event_s;
+
+/* Synthetic workload: background events at random intervals and regular bursts on top of them */
+typedef struct
+{
+    float64_t f64DurationInSeconds;
+    float64_t f64MeanIntervalInSeconds;     /* Background events, the intervals are drawn uniformly from (0, 2 * mean>, 0 for none */
+    float64_t f64BurstPeriodInSeconds;      /* 0 for no bursts */
+    float64_t f64BurstIntervalInSeconds;    /* Between the events of one burst */
+    uint32_t u32EventsPerBurst;
+    Modules_Id_e eModuleId;
+    EventHandler_Severity_e eSeverity;
+    uint32_t u32TypeMask;                   /* Types of the events, drawn uniformly, bit (1 << type) */
+    uint32_t u32Seed;
+} Simulator_Workload_s;
+
+/* Outcome of the simulation */
+typedef struct
+{
+    uint32_t au32GeneratedEvents[EVENTHANDLER_NUMBER_OF_EVENT_TYPES];
+    uint32_t au32ForwardedEvents[EVENTHANDLER_NUMBER_OF_EVENT_TYPES];   /* Reports handed over to the sink */
+    uint32_t au32SuppressedEvents[EVENTHANDLER_NUMBER_OF_EVENT_TYPES];  /* Generated, but not reported */
+    uint32_t au32PeakEventsPerSecond[EVENTHANDLER_NUMBER_OF_EVENT_TYPES];
+    uint32_t u32PeakReportsPerSecond;
+    uint32_t u32NumberOfMinutes;                                        /* Virtual minutes covered, the last one may be partial */
+    uint32_t u32PeakSinkBytesPerMinute;
+    uint64_t u64SinkBytes;
+    uint32_t u32Resets;                                                 /* MEDIUM events, which would have reset the target */
+} Simulator_Results_s;
+
+/* Receiver of the number of the report bytes in each virtual minute, e.g. to plot the link load */
+typedef void (*Simulator_MinuteReport_f)(uint32_t in_u32Minute, uint32_t in_u32SinkBytes);
+
+/**
+ * @brief Starts a simulation at the virtual time 0 with the reporting state cleared
+ *
+ * @param in_pfMinuteReport   Receiver of the bytes per virtual minute, may be NULL
+ * @param in_pfSink           Sink getting the reports as well, e.g. TraceExport_ExportReport, may be NULL;
+ *                            Storage_StoreEventReport is refused, the simulated reports would fill the event log of the target
+ *
+ * @return E_FALSE            The simulation cannot be started (no context left or the sink refused)
+ * @return E_TRUE             The simulation is started
+ */
+boolean Simulator_Start(Simulator_MinuteReport_f in_pfMinuteReport, EventHandler_Sink_f in_pfSink);
+
+/**
+ * @brief Replays the recorded events, a long recording can be replayed in parts
+ *
+ * @param in_psEvents           Events ordered by their time
+ * @param in_u32NumberOfEvents  Number of the events
+ */
+void Simulator_ReplayEvents(const Simulator_Event_s *in_psEvents, uint32_t in_u32NumberOfEvents);
+
+/**
+ * @brief Generates the synthetic workload and replays it, starting at the virtual time reached so far
+ *
+ * @param in_psWorkload   Parameters of the workload
+ */
+void Simulator_RunWorkload(const Simulator_Workload_s *in_psWorkload);
+
+/**
+ * @brief Finishes the simulation
+ *
+ * @param out_psResults   Outcome of the simulation
+ */
+void Simulator_Stop(Simulator_Results_s *out_psResults);
+
+#endif /* __SIMULATOR_H__ */
@@ -0,0 +1,458 @@
+/*
+ ******************************************************************************
+ *                                                                            *
+ *                              Michal Durila                                 *
+ *                                                                            *
+ *                                                                            *
+ *                           ALL RIGHTS RESERVED                              *
+ *                                                                            *
+ ******************************************************************************
+ */
+
+/**
+ *  @file SinkWorker.c
+ *  @author Michal Durila
+ *  @brief This module serves each sink of the event reports by its own thread (host build with EVENTHANDLER_USE_SINK_WORKERS only).
+ *
+ * A submitted report is copied once into a shared slot, every sink gets a reference to it in its
+ * own bounded queue and the slot is released after the last sink has been served. The latencies
+ * of the sinks thus overlap instead of adding up. The pool holds enough slots for all queues to be
+ * full while every sink is delivering and SINKWORKER_MAX_NUMBER_OF_PRODUCERS reports are being
+ * submitted, a report finding no free slot beyond that is dropped for every sink.
+ *
+ * Copyright 2021 Michal Durila, All rights reserved.
+ */
+
+#include "SinkWorker.h"
+
+#if defined(EVENTHANDLER_USE_SINK_WORKERS)
+
+#include "Modules.h"
+
+#include <pthread.h>
+
+
+#define NUMBER_OF_SLOTS                  ((EVENTHANDLER_MAX_NUMBER_OF_SINKS * (SINKWORKER_QUEUE_SIZE + 1U)) + SINKWORKER_MAX_NUMBER_OF_PRODUCERS)
+#define NO_SLOT                          NUMBER_OF_SLOTS
+#define UNINITIALIZED_COUNTER            0U
+
+/* Module ID assignment */
+static const Modules_Id_e m_eModuleId = E_MODULES_ID_SINKWORKER;
+
+/* Typedef containing all defined event instances in this module */
+typedef enum
+{
+    E_EVENT_INSTANCE_SINKWORKER_SUBMITREPORT_NULL        = 0U,
+    E_EVENT_INSTANCE_SINKWORKER_SUBMITREPORT_DATASIZE    = 1U,
+    E_EVENT_INSTANCE_SINKWORKER_SUBMITREPORT_MAXSIZE     = 2U,
+    E_EVENT_INSTANCE_SINKWORKER_START_SINKS              = 3U,
+    E_EVENT_INSTANCE_SINKWORKER_GETSTATISTICS_SINK       = 4U,
+    E_EVENT_INSTANCE_SINKWORKER_GETSTATISTICS_NULL       = 5U
+} EventInstance_e;
+
+/* Report shared by the queues of all sinks */
+typedef struct
+{
+    uint8_t au8Data[SINKWORKER_REPORT_MAX_SIZE_IN_BYTES];
+    uint32_t u32DataSize;
+    uint32_t u32References;
+    uint32_t u32NextFreeSlot;
+} Slot_s;
+
+/* Thread serving one sink and its queue of slot indexes */
+typedef struct
+{
+    EventHandler_Sink_f pfSink;
+    SinkWorker_OverflowPolicy_e eOverflowPolicy;
+    pthread_t sThread;
+    pthread_mutex_t sLock;
+    pthread_cond_t sReportQueued;
+    pthread_cond_t sQueueEmpty;
+    uint32_t au32Queue[SINKWORKER_QUEUE_SIZE];
+    uint32_t u32QueueHead;
+    uint32_t u32QueueLength;
+    boolean bIsDelivering;
+    boolean bIsStopping;
+    SinkWorker_Statistics_s sStatistics;
+} Worker_s;
+
+static Worker_s m_asWorkers[EVENTHANDLER_MAX_NUMBER_OF_SINKS];
+static uint32_t m_u32NumberOfWorkers;
+static boolean m_bIsRunning = E_FALSE;
+
+static Slot_s m_asSlots[NUMBER_OF_SLOTS];
+static uint32_t m_u32FirstFreeSlot = NO_SLOT;
+static pthread_mutex_t m_sSlotsLock = PTHREAD_MUTEX_INITIALIZER;
+
+static void *SinkWorker_Run(void *inout_pvWorker);
+static void SinkWorker_ReleaseSlot(uint32_t in_u32Slot);
+
+
+/**
+ * @brief Starts one thread per sink, does nothing if the threads are already running
+ *
+ * @param in_ppfSinks           Array of the sinks
+ * @param in_peOverflowPolicies Overflow policy of each sink
+ * @param in_u32NumberOfSinks   Number of the sinks, at most EVENTHANDLER_MAX_NUMBER_OF_SINKS
+ */
+void SinkWorker_Start(const EventHandler_Sink_f *in_ppfSinks, const SinkWorker_OverflowPolicy_e *in_peOverflowPolicies, uint32_t in_u32NumberOfSinks)
+{
+    uint32_t u32IterSlot = COMMON_STARTING_INDEX_OF_ARRAY;
+    uint32_t u32IterWorker = COMMON_STARTING_INDEX_OF_ARRAY;
+    Worker_s *psWorker = NULL;
+
+    if ((NULL == in_ppfSinks) || (NULL == in_peOverflowPolicies) || (EVENTHANDLER_MAX_NUMBER_OF_SINKS < in_u32NumberOfSinks))
+    {
+        EventHandler_GenerateEventReportUserData(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_SINKWORKER_START_SINKS, E_EVENTHANDLER_SEVERITY_NORMAL, E_EVENTHANDLER_TYPE_ADDRESSRANGE, in_u32NumberOfSinks);
+        return;
+    }
+
+    if (E_TRUE == m_bIsRunning)
+    {
+        return;
+    }
+
+    for (; NUMBER_OF_SLOTS > u32IterSlot; u32IterSlot++)
+    {
+        m_asSlots[u32IterSlot].u32NextFreeSlot = u32IterSlot + 1U;
+    }
+
+    m_u32FirstFreeSlot = COMMON_STARTING_INDEX_OF_ARRAY;
+
+    for (; in_u32NumberOfSinks > u32IterWorker; u32IterWorker++)
+    {
+        psWorker = &m_asWorkers[u32IterWorker];
+        psWorker->pfSink = in_ppfSinks[u32IterWorker];
+        psWorker->eOverflowPolicy = in_peOverflowPolicies[u32IterWorker];
+        psWorker->u32QueueHead = COMMON_STARTING_INDEX_OF_ARRAY;
+        psWorker->u32QueueLength = UNINITIALIZED_COUNTER;
+        psWorker->bIsDelivering = E_FALSE;
+        psWorker->bIsStopping = E_FALSE;
+        psWorker->sStatistics.u32Backlog = UNINITIALIZED_COUNTER;
+        psWorker->sStatistics.u32MaxBacklog = UNINITIALIZED_COUNTER;
+        psWorker->sStatistics.u32Delivered = UNINITIALIZED_COUNTER;
+        psWorker->sStatistics.u32Dropped = UNINITIALIZED_COUNTER;
+
+        (void) pthread_mutex_init(&psWorker->sLock, NULL);
+        (void) pthread_cond_init(&psWorker->sReportQueued, NULL);
+        (void) pthread_cond_init(&psWorker->sQueueEmpty, NULL);
+        (void) pthread_create(&psWorker->sThread, NULL, SinkWorker_Run, psWorker);
+    }
+
+    m_u32NumberOfWorkers = in_u32NumberOfSinks;
+    m_bIsRunning = E_TRUE;
+
+    return;
+}
+
+/**
+ * @brief Delivers all queued reports and stops the threads
+ */
+void SinkWorker_Stop(void)
+{
+    uint32_t u32IterWorker = COMMON_STARTING_INDEX_OF_ARRAY;
+    Worker_s *psWorker = NULL;
+
+    if (E_FALSE == m_bIsRunning)
+    {
+        return;
+    }
+
+    for (; m_u32NumberOfWorkers > u32IterWorker; u32IterWorker++)
+    {
+        psWorker = &m_asWorkers[u32IterWorker];
+
+        (void) pthread_mutex_lock(&psWorker->sLock);
+        psWorker->bIsStopping = E_TRUE;
+        (void) pthread_cond_signal(&psWorker->sReportQueued);
+        (void) pthread_mutex_unlock(&psWorker->sLock);
+
+        (void) pthread_join(psWorker->sThread, NULL);
+        (void) pthread_cond_destroy(&psWorker->sQueueEmpty);
+        (void) pthread_cond_destroy(&psWorker->sReportQueued);
+        (void) pthread_mutex_destroy(&psWorker->sLock);
+    }
+
+    m_bIsRunning = E_FALSE;
+
+    return;
+}
+
+/**
+ * @brief Waits until all queued reports are delivered
+ */
+void SinkWorker_Flush(void)
+{
+    uint32_t u32IterWorker = COMMON_STARTING_INDEX_OF_ARRAY;
+    Worker_s *psWorker = NULL;
+
+    if (E_FALSE == m_bIsRunning)
+    {
+        return;
+    }
+
+    for (; m_u32NumberOfWorkers > u32IterWorker; u32IterWorker++)
+    {
+        psWorker = &m_asWorkers[u32IterWorker];
+
+        /* A sink thread reporting an event of its own cannot wait for itself */
+        if (0 != pthread_equal(psWorker->sThread, pthread_self()))
+        {
+            continue;
+        }
+
+        (void) pthread_mutex_lock(&psWorker->sLock);
+
+        while ((0U != psWorker->u32QueueLength) || (E_TRUE == psWorker->bIsDelivering))
+        {
+            (void) pthread_cond_wait(&psWorker->sQueueEmpty, &psWorker->sLock);
+        }
+
+        (void) pthread_mutex_unlock(&psWorker->sLock);
+    }
+
+    return;
+}
+
+/**
+ * @brief Copies the report once and queues it for every sink, usable as an EventHandler_Sink_f
+ *
+ * @param in_pu8EventData   Event report data array
+ * @param in_u32DataSize    Size of event report data in bytes
+ */
+void SinkWorker_SubmitReport(const uint8_t *in_pu8EventData, uint32_t in_u32DataSize)
+{
+    uint32_t u32Slot = NO_SLOT;
+    uint32_t u32IterBytes = COMMON_STARTING_INDEX_OF_ARRAY;
+    uint32_t u32IterWorker = COMMON_STARTING_INDEX_OF_ARRAY;
+    uint32_t u32DroppedSlot = NO_SLOT;
+    Worker_s *psWorker = NULL;
+
+    if (NULL == in_pu8EventData)
+    {
+        EventHandler_GenerateEventReport(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_SINKWORKER_SUBMITREPORT_NULL, E_EVENTHANDLER_SEVERITY_MEDIUM, E_EVENTHANDLER_TYPE_NULLARGUMENT);
+        return;
+    }
+
+    if (0U == in_u32DataSize)
+    {
+        EventHandler_GenerateEventReport(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_SINKWORKER_SUBMITREPORT_DATASIZE, E_EVENTHANDLER_SEVERITY_LOW, E_EVENTHANDLER_TYPE_MINDATALENGTH);
+        return;
+    }
+
+    if (SINKWORKER_REPORT_MAX_SIZE_IN_BYTES < in_u32DataSize)
+    {
+        EventHandler_GenerateEventReportUserData(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_SINKWORKER_SUBMITREPORT_MAXSIZE, E_EVENTHANDLER_SEVERITY_NORMAL, E_EVENTHANDLER_TYPE_ADDRESSRANGE, in_u32DataSize);
+        return;
+    }
+
+    if ((E_FALSE == m_bIsRunning) || (0U == m_u32NumberOfWorkers))
+    {
+        return;
+    }
+
+    (void) pthread_mutex_lock(&m_sSlotsLock);
+    u32Slot = m_u32FirstFreeSlot;
+
+    if (NO_SLOT != u32Slot)
+    {
+        m_u32FirstFreeSlot = m_asSlots[u32Slot].u32NextFreeSlot;
+    }
+
+    (void) pthread_mutex_unlock(&m_sSlotsLock);
+
+    /* More producers than the pool is sized for, the report is lost for every sink */
+    if (NO_SLOT == u32Slot)
+    {
+        for (; m_u32NumberOfWorkers > u32IterWorker; u32IterWorker++)
+        {
+            (void) pthread_mutex_lock(&m_asWorkers[u32IterWorker].sLock);
+            m_asWorkers[u32IterWorker].sStatistics.u32Dropped++;
+            (void) pthread_mutex_unlock(&m_asWorkers[u32IterWorker].sLock);
+        }
+
+        return;
+    }
+
+    for (; in_u32DataSize > u32IterBytes; u32IterBytes++)
+    {
+        m_asSlots[u32Slot].au8Data[u32IterBytes] = in_pu8EventData[u32IterBytes];
+    }
+
+    m_asSlots[u32Slot].u32DataSize = in_u32DataSize;
+    m_asSlots[u32Slot].u32References = m_u32NumberOfWorkers;
+
+    for (; m_u32NumberOfWorkers > u32IterWorker; u32IterWorker++)
+    {
+        psWorker = &m_asWorkers[u32IterWorker];
+        u32DroppedSlot = NO_SLOT;
+
+        (void) pthread_mutex_lock(&psWorker->sLock);
+
+        if (SINKWORKER_QUEUE_SIZE <= psWorker->u32QueueLength)
+        {
+            psWorker->sStatistics.u32Dropped++;
+
+            if (E_SINKWORKER_OVERFLOW_DROPOLDEST == psWorker->eOverflowPolicy)
+            {
+                u32DroppedSlot = psWorker->au32Queue[psWorker->u32QueueHead];
+                psWorker->u32QueueHead = (psWorker->u32QueueHead + 1U) % SINKWORKER_QUEUE_SIZE;
+                psWorker->u32QueueLength--;
+            }
+            else
+            {
+                u32DroppedSlot = u32Slot;
+            }
+        }
+
+        if (u32DroppedSlot != u32Slot)
+        {
+            psWorker->au32Queue[(psWorker->u32QueueHead + psWorker->u32QueueLength) % SINKWORKER_QUEUE_SIZE] = u32Slot;
+            psWorker->u32QueueLength++;
+            psWorker->sStatistics.u32Backlog = psWorker->u32QueueLength + (uint32_t) psWorker->bIsDelivering;
+
+            if (psWorker->sStatistics.u32MaxBacklog < psWorker->sStatistics.u32Backlog)
+            {
+                psWorker->sStatistics.u32MaxBacklog = psWorker->sStatistics.u32Backlog;
+            }
+
+            (void) pthread_cond_signal(&psWorker->sReportQueued);
+        }
+
+        (void) pthread_mutex_unlock(&psWorker->sLock);
+
+        if (NO_SLOT != u32DroppedSlot)
+        {
+            SinkWorker_ReleaseSlot(u32DroppedSlot);
+        }
+    }
+
+    return;
+}
+
+/**
+ * @brief Tells whether the calling thread is one of the sink threads
+ *
+ * @return E_FALSE   The caller is another thread
+ * @return E_TRUE    The caller is a sink thread
+ */
+boolean SinkWorker_IsWorkerThread(void)
+{
+    boolean bIsWorkerThread = E_FALSE;
+    uint32_t u32IterWorker = COMMON_STARTING_INDEX_OF_ARRAY;
+
+    if (E_TRUE == m_bIsRunning)
+    {
+        for (; (m_u32NumberOfWorkers > u32IterWorker) && (E_FALSE == bIsWorkerThread); u32IterWorker++)
+        {
+            if (0 != pthread_equal(m_asWorkers[u32IterWorker].sThread, pthread_self()))
+            {
+                bIsWorkerThread = E_TRUE;
+            }
+        }
+    }
+
+    return bIsWorkerThread;
+}
+
+/**
+ * @brief Gives the counters of the sink
+ *
+ * @param in_u32Sink          Index of the sink as passed to SinkWorker_Start
+ * @param out_psStatistics    Counters of the sink
+ */
+void SinkWorker_GetStatistics(uint32_t in_u32Sink, SinkWorker_Statistics_s *out_psStatistics)
+{
+    if (NULL == out_psStatistics)
+    {
+        EventHandler_GenerateEventReport(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_SINKWORKER_GETSTATISTICS_NULL, E_EVENTHANDLER_SEVERITY_MEDIUM, E_EVENTHANDLER_TYPE_NULLARGUMENT);
+        return;
+    }
+
+    if ((E_FALSE == m_bIsRunning) || (m_u32NumberOfWorkers <= in_u32Sink))
+    {
+        EventHandler_GenerateEventReportUserData(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_SINKWORKER_GETSTATISTICS_SINK, E_EVENTHANDLER_SEVERITY_NORMAL, E_EVENTHANDLER_TYPE_ADDRESSRANGE, in_u32Sink);
+        return;
+    }
+
+    (void) pthread_mutex_lock(&m_asWorkers[in_u32Sink].sLock);
+    *out_psStatistics = m_asWorkers[in_u32Sink].sStatistics;
+    (void) pthread_mutex_unlock(&m_asWorkers[in_u32Sink].sLock);
+
+    return;
+}
+
+/**
+ * @brief Thread delivering the queued reports to one sink until it is stopped and its queue is empty
+ *
+ * @param inout_pvWorker   Worker_s served by the thread
+ *
+ * @return                 Always NULL
+ */
+static void *SinkWorker_Run(void *inout_pvWorker)
+{
+    Worker_s *psWorker = (Worker_s *) inout_pvWorker;
+    uint32_t u32Slot = NO_SLOT;
+
+    (void) pthread_mutex_lock(&psWorker->sLock);
+
+    for (;;)
+    {
+        while ((0U == psWorker->u32QueueLength) && (E_FALSE == psWorker->bIsStopping))
+        {
+            (void) pthread_cond_wait(&psWorker->sReportQueued, &psWorker->sLock);
+        }
+
+        if (0U == psWorker->u32QueueLength)
+        {
+            break;
+        }
+
+        u32Slot = psWorker->au32Queue[psWorker->u32QueueHead];
+        psWorker->u32QueueHead = (psWorker->u32QueueHead + 1U) % SINKWORKER_QUEUE_SIZE;
+        psWorker->u32QueueLength--;
+        psWorker->bIsDelivering = E_TRUE;
+        (void) pthread_mutex_unlock(&psWorker->sLock);
+
+        psWorker->pfSink(m_asSlots[u32Slot].au8Data, m_asSlots[u32Slot].u32DataSize);
+        SinkWorker_ReleaseSlot(u32Slot);
+
+        (void) pthread_mutex_lock(&psWorker->sLock);
+        psWorker->bIsDelivering = E_FALSE;
+        psWorker->sStatistics.u32Delivered++;
+        psWorker->sStatistics.u32Backlog = psWorker->u32QueueLength;
+
+        if (0U == psWorker->u32QueueLength)
+        {
+            (void) pthread_cond_broadcast(&psWorker->sQueueEmpty);
+        }
+    }
+
+    (void) pthread_mutex_unlock(&psWorker->sLock);
+
+    return NULL;
+}
+
+/**
+ * @brief Drops one reference to the slot and returns it to the pool after the last one
+ *
+ * @param in_u32Slot   Index of the slot
+ */
+static void SinkWorker_ReleaseSlot(uint32_t in_u32Slot)
+{
+    (void) pthread_mutex_lock(&m_sSlotsLock);
+
+    m_asSlots[in_u32Slot].u32References--;
+
+    if (0U == m_asSlots[in_u32Slot].u32References)
+    {
+        m_asSlots[in_u32Slot].u32NextFreeSlot = m_u32FirstFreeSlot;
+        m_u32FirstFreeSlot = in_u32Slot;
+    }
+
+    (void) pthread_mutex_unlock(&m_sSlotsLock);
+
+    return;
+}
+
+#endif /* EVENTHANDLER_USE_SINK_WORKERS */
@@ -0,0 +1,91 @@
+/*
+ ******************************************************************************
+ *                                                                            *
+ *                              Michal Durila                                 *
+ *                                                                            *
+ *                                                                            *
+ *                           ALL RIGHTS RESERVED                              *
+ *                                                                            *
+ ******************************************************************************
+ */
+
+/**
+ *  @file SinkWorker.h
+ *  @author Michal Durila
+ *  @brief This module serves each sink of the event reports by its own thread (host build with EVENTHANDLER_USE_SINK_WORKERS only).
+ *
+ * Copyright 2021 Michal Durila, All rights reserved.
+ */
+
+#ifndef __SINKWORKER_H__
+#define __SINKWORKER_H__
+
+#include "Common.h"
+#include "EventHandler.h"
+
+/* Reports waiting for one sink */
+#define SINKWORKER_QUEUE_SIZE              32U
+#define SINKWORKER_REPORT_MAX_SIZE_IN_BYTES 1024U
+/* Threads submitting reports at the same time, each one holds a slot until its report is queued */
+#define SINKWORKER_MAX_NUMBER_OF_PRODUCERS  4U
+
+/* Typedef containing all policies applied when the queue of a sink is full */
+typedef enum
+{
+    E_SINKWORKER_OVERFLOW_DROPNEWEST = 0U,
+    E_SINKWORKER_OVERFLOW_DROPOLDEST = 1U
+} SinkWorker_OverflowPolicy_e;
+
+/* Counters of one sink */
+typedef struct
+{
+    uint32_t u32Backlog;            /* Reports queued or being delivered right now */
+    uint32_t u32MaxBacklog;
+    uint32_t u32Delivered;
+    uint32_t u32Dropped;
+} SinkWorker_Statistics_s;
+
+/**
+ * @brief Starts one thread per sink, does nothing if the threads are already running
+ *
+ * @param in_ppfSinks           Array of the sinks
+ * @param in_peOverflowPolicies Overflow policy of each sink
+ * @param in_u32NumberOfSinks   Number of the sinks, at most EVENTHANDLER_MAX_NUMBER_OF_SINKS
+ */
+void SinkWorker_Start(const EventHandler_Sink_f *in_ppfSinks, const SinkWorker_OverflowPolicy_e *in_peOverflowPolicies, uint32_t in_u32NumberOfSinks);
+
+/**
+ * @brief Delivers all queued reports and stops the threads
+ */
+void SinkWorker_Stop(void);
+
+/**
+ * @brief Waits until all queued reports are delivered
+ */
+void SinkWorker_Flush(void);
+
+/**
+ * @brief Copies the report once and queues it for every sink, usable as an EventHandler_Sink_f
+ *
+ * @param in_pu8EventData   Event report data array
+ * @param in_u32DataSize    Size of event report data in bytes
+ */
+void SinkWorker_SubmitReport(const uint8_t *in_pu8EventData, uint32_t in_u32DataSize);
+
+/**
+ * @brief Tells whether the calling thread is one of the sink threads
+ *
+ * @return E_FALSE   The caller is another thread
+ * @return E_TRUE    The caller is a sink thread
+ */
+boolean SinkWorker_IsWorkerThread(void);
+
+/**
+ * @brief Gives the counters of the sink
+ *
+ * @param in_u32Sink          Index of the sink as passed to SinkWorker_Start
+ * @param out_psStatistics    Counters of the sink
+ */
+void SinkWorker_GetStatistics(uint32_t in_u32Sink, SinkWorker_Statistics_s *out_psStatistics);
+
+#endif /* __SINKWORKER_H__ */
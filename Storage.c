@@ -14,37 +14,1078 @@
  *  @author Michal Durila
  *  @brief This module stores/loads data to/from local non-volatile memory.
  *
+ * The event reports are kept in a circular log spanning the whole NVM window. Every sector starts
+ * with a header holding a sequence number, which grows by one with each newly opened sector, so
+ * the sector being written (head) can be found by a binary search over the sector headers.
+ *
+ * The sectors following the head are the oldest ones and get erased next. An incremental compactor
+ * runs a few sectors ahead of the head, a bounded slice of records with each stored report, and
+ * copies the records of the retained severities to the head within the per-lap quotas. A record is
+ * flagged once copied and a finished sector is marked as compacted, so a restart repeats no copy.
+ * Every copy counts its generation in the flags, so a report expires after STORAGE_RETENTION_MAX_CARRIES
+ * copies and the quotas are left to the newer reports.
+ *
+ * Every sector header is completed by the sequence number of the first report written into the
+ * sector (copies excluded). These numbers grow with the age of the sectors, so the reports asked
+ * for by the receiver are found by a binary search over the sector headers as well, limited to the
+ * sectors written so far until the log wraps around. The copies stand in for the reports older than
+ * the oldest sector still indexed, so a request reaching them scans the whole log for them first.
+ *
  * Copyright 2021 Michal Durila, All rights reserved.
  */
 
 #include "Storage.h"
 #include "Modules.h"
+#include "NvmMem.h"
+#include "EventHandler.h"
 
-#include <stdio.h>
 
+#define LOG_START_ADDRESS                NVMMEM_ADDRESS_LOW_LIM
+#define LOG_NUMBER_OF_SECTORS            ((NVMMEM_ADDRESS_HIGH_LIM - NVMMEM_ADDRESS_LOW_LIM) / NVMMEM_SECTOR_SIZE_IN_BYTES)
+#define SECTOR_MAGIC                     0x45564C47U
+#define SECTOR_HEADER_SIZE_IN_BYTES      20U
+#define SECTOR_HEADER_MAGIC_OFFSET       0U
+#define SECTOR_HEADER_SEQUENCE_OFFSET    4U
+#define SECTOR_HEADER_CHECKSUM_OFFSET    8U
+#define SECTOR_HEADER_STATE_OFFSET       12U
+#define SECTOR_HEADER_FIRST_REPORT_OFFSET 16U
+#define SECTOR_STATE_COMPACTED           0x00000000U
+#define RECORD_MARKER                    0xA5U
+#define RECORD_MARKER_SHIFT              24U
+#define RECORD_LENGTH_MASK               0x0000FFFFU
+#define RECORD_FLAGS_BITS                0x00FF0000U
+#define RECORD_FLAGS_OFFSET              1U
+#define RECORD_FLAGS_UNSET               0xFFU
+#define RECORD_FLAG_CARRIED              0x01U
+#define RECORD_FLAG_COPY                 0x02U
+#define RECORD_FLAGS_GENERATIONS         0xFCU
+#define RECORD_HEADER_SIZE_IN_BYTES      4U
+#define RECORD_CHECKSUM_SIZE_IN_BYTES    4U
+#define RECORD_MAX_DATA_SIZE_IN_BYTES    256U
+#define RECORD_MAX_SIZE_IN_BYTES         (RECORD_HEADER_SIZE_IN_BYTES + RECORD_MAX_DATA_SIZE_IN_BYTES + RECORD_CHECKSUM_SIZE_IN_BYTES)
+#define ERASED_WORD                      0xFFFFFFFFU
+#define CHECKSUM_INITIAL_VALUE           0xFFFFFFFFU
+#define CHECKSUM_POLYNOMIAL              0xEDB88320U
+#define EXTRACT_ONE_BYTE                 0xFFU
+#define FIRST_SECTOR                     0U
+#define INITIAL_SEQUENCE_NUMBER          0U
+#define COMPACTION_SLICE_IN_RECORDS      8U
+#define COMPACTION_LOOKAHEAD_IN_SECTORS  8U
 
 /* Module ID assignment */
 static const Modules_Id_e m_eModuleId = E_MODULES_ID_STORAGE;
 
+/* Typedef containing all defined event instances in this module */
+typedef enum
+{
+    E_EVENT_INSTANCE_STORAGE_STOREEVENTREPORT_NULL       = 0U,
+    E_EVENT_INSTANCE_STORAGE_STOREEVENTREPORT_DATASIZE   = 1U,
+    E_EVENT_INSTANCE_STORAGE_STOREEVENTREPORT_MAXSIZE    = 2U,
+    E_EVENT_INSTANCE_STORAGE_SETRETENTIONQUOTA_SEVERITIES = 3U,
+    E_EVENT_INSTANCE_STORAGE_GETRETENTIONSTATISTICS_NULL = 4U,
+    E_EVENT_INSTANCE_STORAGE_LOADEVENTREPORTS_NULL       = 5U,
+    E_EVENT_INSTANCE_STORAGE_LOADEVENTREPORTS_RANGE      = 6U
+} EventInstance_e;
+
+/* Typedef containing the results of reading a record */
+typedef enum
+{
+    E_RECORD_VALID  = 0U,
+    E_RECORD_ERASED = 1U,
+    E_RECORD_TORN   = 2U
+} RecordState_e;
+
+static boolean m_bIsInitialized = E_FALSE;
+static uint32_t m_u32HeadSector;
+static uint32_t m_u32HeadSequence;
+static uint32_t m_u32HeadOffset;
+static boolean m_bIsHeadIndexed;
+
+/* Number of the sectors written so far, the head is the newest of them; all the sectors once the log wrapped around */
+static uint32_t m_u32NumberOfUsedSectors;
+
+/* Sequence number following the newest stored report */
+static boolean m_bIsNextSequenceNumberKnown;
+static uint32_t m_u32NextSequenceNumber;
+
+/* Sector to be compacted before the head reaches it and the offset of its next record */
+static uint32_t m_u32CompactSector;
+static uint32_t m_u32CompactOffset;
+static uint32_t m_au32RetentionQuota[EVENTHANDLER_NUMBER_OF_EVENT_SEVERITIES] =
+{
+    STORAGE_DEFAULT_QUOTA_LOW,
+    STORAGE_DEFAULT_QUOTA_NORMAL,
+    STORAGE_DEFAULT_QUOTA_MEDIUM
+};
+static uint32_t m_au32CarriedRecordsInLap[EVENTHANDLER_NUMBER_OF_EVENT_SEVERITIES];
+
+/* Head sector at the start of the lap, where its first copy went, the compaction reaching it starts the next lap */
+static uint32_t m_u32LapEndSector;
+static Storage_RetentionStatistics_s m_sRetentionStatistics;
+
+static boolean Storage_ReadSectorSequence(uint32_t in_u32Sector, uint32_t *out_pu32Sequence);
+static void Storage_OpenSector(uint32_t in_u32Sector, uint32_t in_u32Sequence);
+static void Storage_StoreRecord(const uint8_t *in_pu8Data, uint32_t in_u32DataSize);
+static void Storage_AdvanceHead(void);
+static void Storage_AppendRecord(const uint8_t *in_pu8Record, uint32_t in_u32RecordSize);
+static void Storage_ResetCompaction(void);
+static void Storage_StartLap(void);
+static void Storage_CompactSlice(void);
+static void Storage_CarryRecord(uint32_t in_u32Address, uint8_t *inout_pu8Record, uint32_t in_u32RecordSize);
+static uint32_t Storage_GetRecordGeneration(uint8_t in_u8Flags);
+static void Storage_CloseCompactedSector(boolean in_bIsCompacted);
+static boolean Storage_IsSectorCompacted(uint32_t in_u32Sector);
+static uint32_t Storage_GetDistanceFromHead(uint32_t in_u32Sector);
+static uint32_t Storage_GetSectorOfAge(uint32_t in_u32Age);
+static boolean Storage_ReadReportSequenceNumber(const uint8_t *in_pu8Record, uint32_t in_u32RecordSize, uint32_t *out_pu32SequenceNumber);
+static boolean Storage_IsRecordCopy(const uint8_t *in_pu8Record);
+static void Storage_UpdateNextSequenceNumber(const uint8_t *in_pu8Record, uint32_t in_u32RecordSize);
+static boolean Storage_ReadFirstReportSequenceNumber(uint32_t in_u32Sector, uint32_t *out_pu32SequenceNumber);
+static uint32_t Storage_LoadSectorReports(uint32_t in_u32Sector, uint32_t in_u32FirstSequenceNumber, uint32_t in_u32LastSequenceNumber, EventHandler_Sink_f in_pfReceiver, boolean in_bAreCopiesLoaded);
+static RecordState_e Storage_ReadRecord(uint32_t in_u32Address, uint8_t *out_pu8Record, uint32_t *out_pu32RecordSize);
+static uint32_t Storage_GetSectorAddress(uint32_t in_u32Sector);
+static uint32_t Storage_CalculateChecksum(const uint8_t *in_pu8Data, uint32_t in_u32DataSize);
+static void Storage_WriteWord(uint8_t *out_pu8Data, uint32_t in_u32Word);
+
 
 /**
- * @brief The function stores event report in local memory.
+ * @brief Recovers the write head of the event log: finds the newest sector by a binary search
+ *        over the sector headers, validates its records only and truncates a torn record,
+ *        then resumes the compaction after the sectors already compacted
+ *        and the report numbering after the newest report
+ */
+void Storage_Initialize(void)
+{
+    uint32_t u32FirstSequence = INITIAL_SEQUENCE_NUMBER;
+    uint32_t u32Sequence = INITIAL_SEQUENCE_NUMBER;
+    uint32_t u32LowSector = FIRST_SECTOR;
+    uint32_t u32HighSector = LOG_NUMBER_OF_SECTORS;
+    uint32_t u32MiddleSector = FIRST_SECTOR;
+    uint32_t u32RecordSize = 0U;
+    uint8_t au8Record[RECORD_MAX_SIZE_IN_BYTES];
+    RecordState_e eRecordState = E_RECORD_VALID;
+
+    m_bIsInitialized = E_TRUE;
+    m_bIsNextSequenceNumberKnown = E_FALSE;
+    m_u32NextSequenceNumber = INITIAL_SEQUENCE_NUMBER;
+
+    if (E_TRUE == Storage_ReadSectorSequence(FIRST_SECTOR, &u32FirstSequence))
+    {
+        /* Sectors of the current lap carry (first sequence + index), all the following sectors are older or erased */
+        while ((u32HighSector - u32LowSector) > 1U)
+        {
+            u32MiddleSector = u32LowSector + ((u32HighSector - u32LowSector) / 2U);
+
+            if ((E_TRUE == Storage_ReadSectorSequence(u32MiddleSector, &u32Sequence)) && ((u32Sequence - u32FirstSequence) == u32MiddleSector))
+            {
+                u32LowSector = u32MiddleSector;
+            }
+            else
+            {
+                u32HighSector = u32MiddleSector;
+            }
+        }
+
+        m_u32HeadSector = u32LowSector;
+        m_u32HeadSequence = u32FirstSequence + u32LowSector;
+
+        /* The log has wrapped around if the last sector was written before */
+        m_u32NumberOfUsedSectors = (E_TRUE == Storage_ReadSectorSequence(LOG_NUMBER_OF_SECTORS - 1U, &u32Sequence)) ? LOG_NUMBER_OF_SECTORS : (u32LowSector + 1U);
+    }
+    else if (E_TRUE == Storage_ReadSectorSequence(LOG_NUMBER_OF_SECTORS - 1U, &u32Sequence))
+    {
+        /* The erasure of the first sector was interrupted when the log wrapped around */
+        m_u32HeadSector = LOG_NUMBER_OF_SECTORS - 1U;
+        m_u32HeadSequence = u32Sequence;
+        m_u32NumberOfUsedSectors = LOG_NUMBER_OF_SECTORS;
+    }
+    else
+    {
+        /* Empty log */
+        m_u32NumberOfUsedSectors = 0U;
+        Storage_OpenSector(FIRST_SECTOR, INITIAL_SEQUENCE_NUMBER);
+        Storage_ResetCompaction();
+        return;
+    }
+
+    m_u32HeadOffset = SECTOR_HEADER_SIZE_IN_BYTES;
+    m_bIsHeadIndexed = Storage_ReadFirstReportSequenceNumber(m_u32HeadSector, &u32Sequence);
+
+    do
+    {
+        eRecordState = E_RECORD_ERASED;
+
+        if ((m_u32HeadOffset + RECORD_HEADER_SIZE_IN_BYTES) <= NVMMEM_SECTOR_SIZE_IN_BYTES)
+        {
+            eRecordState = Storage_ReadRecord(Storage_GetSectorAddress(m_u32HeadSector) + m_u32HeadOffset, au8Record, &u32RecordSize);
+        }
+
+        if (E_RECORD_VALID == eRecordState)
+        {
+            Storage_UpdateNextSequenceNumber(au8Record, u32RecordSize);
+            m_u32HeadOffset += u32RecordSize;
+        }
+    } while (E_RECORD_VALID == eRecordState);
+
+    /* The head may hold copies only, then the newest report is in the previous sector */
+    if (E_FALSE == m_bIsHeadIndexed)
+    {
+        (void) Storage_LoadSectorReports((m_u32HeadSector + LOG_NUMBER_OF_SECTORS - 1U) % LOG_NUMBER_OF_SECTORS, INITIAL_SEQUENCE_NUMBER, INITIAL_SEQUENCE_NUMBER, NULL, E_FALSE);
+    }
+
+    if (E_RECORD_TORN == eRecordState)
+    {
+        /* The programmed bytes of a torn record cannot be overwritten, so the rest of the sector is given up */
+        Storage_OpenSector((m_u32HeadSector + 1U) % LOG_NUMBER_OF_SECTORS, m_u32HeadSequence + 1U);
+    }
+
+    Storage_ResetCompaction();
+
+    return;
+}
+
+/**
+ * @brief The function stores event report in local memory and runs one slice of the compaction.
+ *        Several reports handed over back to back are stored as separate records,
+ *        each one together with the context data it declares, the storing stops at a report
+ *        declaring more than EVENTHANDLER_CONTEXT_DATA_MAX_SIZE_IN_BYTES of them.
  *
  * @param in_pu8EventData   Event report data array
  * @param in_u32DataSize    Size of event report data in bytes
  */
 void Storage_StoreEventReport(const uint8_t *in_pu8EventData, uint32_t in_u32DataSize)
 {
+    uint32_t u32ReportSize = in_u32DataSize;
+    uint32_t u32DeclaredReportSize = in_u32DataSize;
+    uint32_t u32IterReports = COMMON_STARTING_INDEX_OF_ARRAY;
+
+    if (NULL == in_pu8EventData)
+    {
+        EventHandler_GenerateEventReport(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_STORAGE_STOREEVENTREPORT_NULL, E_EVENTHANDLER_SEVERITY_MEDIUM, E_EVENTHANDLER_TYPE_NULLARGUMENT);
+        return;
+    }
+
+    if (0U == in_u32DataSize)
+    {
+        EventHandler_GenerateEventReport(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_STORAGE_STOREEVENTREPORT_DATASIZE, E_EVENTHANDLER_SEVERITY_LOW, E_EVENTHANDLER_TYPE_MINDATALENGTH);
+        return;
+    }
+
+    if (E_FALSE == m_bIsInitialized)
+    {
+        Storage_Initialize();
+    }
+
+    for (; in_u32DataSize > u32IterReports; u32IterReports += u32ReportSize)
+    {
+        /* Data not holding a whole report are stored as one record */
+        u32ReportSize = in_u32DataSize - u32IterReports;
+        u32DeclaredReportSize = u32ReportSize;
+
+        if (EVENTHANDLER_REPORT_SIZE_IN_BYTES <= u32ReportSize)
+        {
+            u32DeclaredReportSize = EventHandler_GetReportSize(&in_pu8EventData[u32IterReports]);
+        }
+
+        if (EVENTHANDLER_INVALID_REPORT_SIZE == u32DeclaredReportSize)
+        {
+            /* The end of the report and so the start of the next one are unknown */
+            EventHandler_GenerateEventReportUserData(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_STORAGE_STOREEVENTREPORT_MAXSIZE, E_EVENTHANDLER_SEVERITY_NORMAL, E_EVENTHANDLER_TYPE_ADDRESSRANGE, EventHandler_ReadWord(&in_pu8EventData[u32IterReports + EVENTHANDLER_REPORT_CONTEXT_SIZE_OFFSET]));
+            break;
+        }
+
+        if (u32ReportSize > u32DeclaredReportSize)
+        {
+            u32ReportSize = u32DeclaredReportSize;
+        }
+
+        if (RECORD_MAX_DATA_SIZE_IN_BYTES < u32ReportSize)
+        {
+            EventHandler_GenerateEventReportUserData(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_STORAGE_STOREEVENTREPORT_MAXSIZE, E_EVENTHANDLER_SEVERITY_NORMAL, E_EVENTHANDLER_TYPE_ADDRESSRANGE, u32ReportSize);
+            break;
+        }
+
+        Storage_StoreRecord(&in_pu8EventData[u32IterReports], u32ReportSize);
+        Storage_CompactSlice();
+    }
+
+    return;
+}
+
+/**
+ * @brief The function gives the sequence number following the newest stored report.
+ *
+ * @return    Sequence number of the next report, 0 for an empty log
+ */
+uint32_t Storage_GetNextSequenceNumber(void)
+{
+    if (E_FALSE == m_bIsInitialized)
+    {
+        Storage_Initialize();
+    }
+
+    return m_u32NextSequenceNumber;
+}
+
+/**
+ * @brief The function hands the stored reports with sequence numbers in the range over to the receiver, the oldest first.
+ *        The retained copies of the overwritten reports go first in the order of the log, a copying interrupted
+ *        by a reset may hand such a report over twice.
+ *
+ * @param in_u32FirstSequenceNumber   First sequence number of the range
+ * @param in_u32LastSequenceNumber    Last sequence number of the range (included)
+ * @param in_pfReceiver               Receiver of the reports, e.g. Comm_SendEventReport
+ *
+ * @return                            Number of the reports handed over
+ */
+uint32_t Storage_LoadEventReports(uint32_t in_u32FirstSequenceNumber, uint32_t in_u32LastSequenceNumber, EventHandler_Sink_f in_pfReceiver)
+{
+    uint32_t u32LowAge = COMMON_STARTING_INDEX_OF_ARRAY;
+    uint32_t u32HighAge = COMMON_STARTING_INDEX_OF_ARRAY;
+    uint32_t u32MiddleAge = COMMON_STARTING_INDEX_OF_ARRAY;
+    uint32_t u32IterAge = COMMON_STARTING_INDEX_OF_ARRAY;
+    uint32_t u32Sector = FIRST_SECTOR;
+    uint32_t u32SequenceNumber = INITIAL_SEQUENCE_NUMBER;
+    uint32_t u32OldestSequenceNumber = INITIAL_SEQUENCE_NUMBER;
+    boolean bIsOldestKnown = E_FALSE;
+    uint32_t u32NumberOfReports = 0U;
+
+    if (NULL == in_pfReceiver)
+    {
+        EventHandler_GenerateEventReport(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_STORAGE_LOADEVENTREPORTS_NULL, E_EVENTHANDLER_SEVERITY_MEDIUM, E_EVENTHANDLER_TYPE_NULLARGUMENT);
+        return u32NumberOfReports;
+    }
+
+    if (in_u32FirstSequenceNumber > in_u32LastSequenceNumber)
+    {
+        EventHandler_GenerateEventReportUserData(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_STORAGE_LOADEVENTREPORTS_RANGE, E_EVENTHANDLER_SEVERITY_LOW, E_EVENTHANDLER_TYPE_ADDRESSRANGE, in_u32FirstSequenceNumber);
+        return u32NumberOfReports;
+    }
+
+    if (E_FALSE == m_bIsInitialized)
+    {
+        Storage_Initialize();
+    }
+
+    /* The oldest report kept in its own sector, only the copies are left of the older ones */
+    for (u32IterAge = COMMON_STARTING_INDEX_OF_ARRAY; (m_u32NumberOfUsedSectors > u32IterAge) && (E_FALSE == bIsOldestKnown); u32IterAge++)
+    {
+        bIsOldestKnown = Storage_ReadFirstReportSequenceNumber(Storage_GetSectorOfAge(u32IterAge), &u32OldestSequenceNumber);
+    }
+
+    if ((E_FALSE == bIsOldestKnown) || (in_u32FirstSequenceNumber < u32OldestSequenceNumber))
+    {
+        u32SequenceNumber = ((E_FALSE == bIsOldestKnown) || (in_u32LastSequenceNumber < u32OldestSequenceNumber)) ? in_u32LastSequenceNumber : (u32OldestSequenceNumber - 1U);
+
+        for (u32IterAge = COMMON_STARTING_INDEX_OF_ARRAY; m_u32NumberOfUsedSectors > u32IterAge; u32IterAge++)
+        {
+            u32NumberOfReports += Storage_LoadSectorReports(Storage_GetSectorOfAge(u32IterAge), in_u32FirstSequenceNumber, u32SequenceNumber, in_pfReceiver, E_TRUE);
+        }
+    }
+
+    /* Only the written sectors are searched, the erased ones ahead of the head before the log wraps around hold nothing */
+    u32HighAge = m_u32NumberOfUsedSectors;
+
+    /* Finds the newest sector starting at or before the range, sectors of unknown start shift the search to the older ones */
+    while ((u32HighAge - u32LowAge) > 1U)
+    {
+        u32MiddleAge = u32LowAge + ((u32HighAge - u32LowAge) / 2U);
+        u32Sector = Storage_GetSectorOfAge(u32MiddleAge);
+
+        if ((E_TRUE == Storage_ReadFirstReportSequenceNumber(u32Sector, &u32SequenceNumber)) && (in_u32FirstSequenceNumber >= u32SequenceNumber))
+        {
+            u32LowAge = u32MiddleAge;
+        }
+        else
+        {
+            u32HighAge = u32MiddleAge;
+        }
+    }
+
+    for (u32IterAge = u32LowAge; m_u32NumberOfUsedSectors > u32IterAge; u32IterAge++)
+    {
+        u32Sector = Storage_GetSectorOfAge(u32IterAge);
+
+        if ((E_TRUE == Storage_ReadFirstReportSequenceNumber(u32Sector, &u32SequenceNumber)) && (in_u32LastSequenceNumber < u32SequenceNumber))
+        {
+            break;
+        }
+
+        u32NumberOfReports += Storage_LoadSectorReports(u32Sector, in_u32FirstSequenceNumber, in_u32LastSequenceNumber, in_pfReceiver, E_FALSE);
+    }
+
+    return u32NumberOfReports;
+}
+
+/**
+ * @brief The function sets how many reports of the severity are carried forward during one lap of the log.
+ *
+ * @param in_eSeverity               Event severity
+ * @param in_u32MaxCarriedRecords    Quota of the severity, 0 lets the reports be overwritten
+ */
+void Storage_SetRetentionQuota(EventHandler_Severity_e in_eSeverity, uint32_t in_u32MaxCarriedRecords)
+{
+    /* Someone may have forgotten to change (increment) the number of event severities */
+    if (EVENTHANDLER_NUMBER_OF_EVENT_SEVERITIES <= (uint32_t) in_eSeverity)
+    {
+        EventHandler_GenerateEventReportUserData(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_STORAGE_SETRETENTIONQUOTA_SEVERITIES, E_EVENTHANDLER_SEVERITY_NORMAL, E_EVENTHANDLER_TYPE_UNUPDATEDCONSTANTS, (uint32_t) in_eSeverity);
+        return;
+    }
+
+    m_au32RetentionQuota[in_eSeverity] = in_u32MaxCarriedRecords;
+
+    return;
+}
+
+/**
+ * @brief The function gives the counters of the retention.
+ *
+ * @param out_psStatistics    Counters of the retention
+ */
+void Storage_GetRetentionStatistics(Storage_RetentionStatistics_s *out_psStatistics)
+{
+    if (NULL == out_psStatistics)
+    {
+        EventHandler_GenerateEventReport(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_STORAGE_GETRETENTIONSTATISTICS_NULL, E_EVENTHANDLER_SEVERITY_MEDIUM, E_EVENTHANDLER_TYPE_NULLARGUMENT);
+        return;
+    }
+
+    *out_psStatistics = m_sRetentionStatistics;
+
+    return;
+}
+
+/**
+ * @brief Reads and validates the header of a sector
+ *
+ * @param in_u32Sector        Index of the sector in the log
+ * @param out_pu32Sequence    Sequence number of the sector
+ *
+ * @return E_FALSE            The sector is erased or its header is damaged
+ * @return E_TRUE             The sector header is valid
+ */
+static boolean Storage_ReadSectorSequence(uint32_t in_u32Sector, uint32_t *out_pu32Sequence)
+{
+    uint8_t au8Header[SECTOR_HEADER_SIZE_IN_BYTES];
     uint32_t u32IterBytes = COMMON_STARTING_INDEX_OF_ARRAY;
+    boolean bIsValid = E_FALSE;
+
+    /* Reads as an erased sector if the memory access fails */
+    for (; SECTOR_HEADER_SIZE_IN_BYTES > u32IterBytes; u32IterBytes++)
+    {
+        au8Header[u32IterBytes] = NVMMEM_ERASED_BYTE;
+    }
+
+    NvmMem_Read(Storage_GetSectorAddress(in_u32Sector), au8Header, SECTOR_HEADER_SIZE_IN_BYTES);
+
+    if ((SECTOR_MAGIC == EventHandler_ReadWord(&au8Header[SECTOR_HEADER_MAGIC_OFFSET])) &&
+        (Storage_CalculateChecksum(au8Header, SECTOR_HEADER_CHECKSUM_OFFSET) == EventHandler_ReadWord(&au8Header[SECTOR_HEADER_CHECKSUM_OFFSET])))
+    {
+        *out_pu32Sequence = EventHandler_ReadWord(&au8Header[SECTOR_HEADER_SEQUENCE_OFFSET]);
+        bIsValid = E_TRUE;
+    }
+
+    return bIsValid;
+}
+
+/**
+ * @brief Erases the sector, writes its header and makes it the head of the log
+ *
+ * @param in_u32Sector     Index of the sector in the log
+ * @param in_u32Sequence   Sequence number of the sector
+ */
+static void Storage_OpenSector(uint32_t in_u32Sector, uint32_t in_u32Sequence)
+{
+    uint8_t au8Header[SECTOR_HEADER_SIZE_IN_BYTES];
 
-    printf("Storage_StoreEventReport: Module ID = %u, Received message = 0x", m_eModuleId);
+    Storage_WriteWord(&au8Header[SECTOR_HEADER_MAGIC_OFFSET], SECTOR_MAGIC);
+    Storage_WriteWord(&au8Header[SECTOR_HEADER_SEQUENCE_OFFSET], in_u32Sequence);
+    Storage_WriteWord(&au8Header[SECTOR_HEADER_CHECKSUM_OFFSET], Storage_CalculateChecksum(au8Header, SECTOR_HEADER_CHECKSUM_OFFSET));
+    Storage_WriteWord(&au8Header[SECTOR_HEADER_STATE_OFFSET], ERASED_WORD);
+    Storage_WriteWord(&au8Header[SECTOR_HEADER_FIRST_REPORT_OFFSET], ERASED_WORD);
+
+    NvmMem_EraseSector(Storage_GetSectorAddress(in_u32Sector));
+    NvmMem_Write(Storage_GetSectorAddress(in_u32Sector), au8Header, SECTOR_HEADER_SIZE_IN_BYTES);
+
+    m_u32HeadSector = in_u32Sector;
+    m_u32HeadSequence = in_u32Sequence;
+    m_u32HeadOffset = SECTOR_HEADER_SIZE_IN_BYTES;
+    m_bIsHeadIndexed = E_FALSE;
+
+    if (LOG_NUMBER_OF_SECTORS > m_u32NumberOfUsedSectors)
+    {
+        m_u32NumberOfUsedSectors++;
+    }
+
+    return;
+}
+
+/**
+ * @brief Wraps the data into a record with its header and checksum and writes it at the head
+ *
+ * @param in_pu8Data       Data array
+ * @param in_u32DataSize   Size of the data in bytes, at most RECORD_MAX_DATA_SIZE_IN_BYTES
+ */
+static void Storage_StoreRecord(const uint8_t *in_pu8Data, uint32_t in_u32DataSize)
+{
+    uint8_t au8Record[RECORD_MAX_SIZE_IN_BYTES];
+    uint8_t au8Index[COMMON_UINT32_SIZE_IN_BYTES];
+    uint32_t u32IterBytes = COMMON_STARTING_INDEX_OF_ARRAY;
+    uint32_t u32SequenceNumber = INITIAL_SEQUENCE_NUMBER;
+
+    Storage_WriteWord(au8Record, ((uint32_t) RECORD_MARKER << RECORD_MARKER_SHIFT) | RECORD_FLAGS_BITS | in_u32DataSize);
 
     for (; in_u32DataSize > u32IterBytes; u32IterBytes++)
     {
-        printf("%X ", *(in_pu8EventData + u32IterBytes));
+        au8Record[RECORD_HEADER_SIZE_IN_BYTES + u32IterBytes] = in_pu8Data[u32IterBytes];
+    }
+
+    Storage_WriteWord(&au8Record[RECORD_HEADER_SIZE_IN_BYTES + in_u32DataSize], Storage_CalculateChecksum(au8Record, RECORD_HEADER_SIZE_IN_BYTES + in_u32DataSize));
+    Storage_AppendRecord(au8Record, RECORD_HEADER_SIZE_IN_BYTES + in_u32DataSize + RECORD_CHECKSUM_SIZE_IN_BYTES);
+
+    /* The first report of the sector indexes it, programmed only after the report itself */
+    if ((E_FALSE == m_bIsHeadIndexed) && (E_TRUE == Storage_ReadReportSequenceNumber(au8Record, RECORD_HEADER_SIZE_IN_BYTES + in_u32DataSize + RECORD_CHECKSUM_SIZE_IN_BYTES, &u32SequenceNumber)))
+    {
+        Storage_WriteWord(au8Index, u32SequenceNumber);
+        NvmMem_Write(Storage_GetSectorAddress(m_u32HeadSector) + SECTOR_HEADER_FIRST_REPORT_OFFSET, au8Index, COMMON_UINT32_SIZE_IN_BYTES);
+        m_bIsHeadIndexed = E_TRUE;
+    }
+
+    Storage_UpdateNextSequenceNumber(au8Record, RECORD_HEADER_SIZE_IN_BYTES + in_u32DataSize + RECORD_CHECKSUM_SIZE_IN_BYTES);
+
+    return;
+}
+
+/**
+ * @brief Opens the sector following the head, gives up the rest of it if the compactor has not finished it yet
+ */
+static void Storage_AdvanceHead(void)
+{
+    uint32_t u32NextSector = (m_u32HeadSector + 1U) % LOG_NUMBER_OF_SECTORS;
+
+    if (u32NextSector == m_u32CompactSector)
+    {
+        m_sRetentionStatistics.u32OverrunSectors++;
+        Storage_CloseCompactedSector(E_FALSE);
+    }
+
+    Storage_OpenSector(u32NextSector, m_u32HeadSequence + 1U);
+
+    return;
+}
+
+/**
+ * @brief Writes the complete record at the head, moves the head to the next sector if the record does not fit
+ *
+ * @param in_pu8Record       Record with its header and checksum
+ * @param in_u32RecordSize   Size of the whole record in bytes
+ */
+static void Storage_AppendRecord(const uint8_t *in_pu8Record, uint32_t in_u32RecordSize)
+{
+    if ((m_u32HeadOffset + in_u32RecordSize) > NVMMEM_SECTOR_SIZE_IN_BYTES)
+    {
+        Storage_AdvanceHead();
+    }
+
+    NvmMem_Write(Storage_GetSectorAddress(m_u32HeadSector) + m_u32HeadOffset, in_pu8Record, in_u32RecordSize);
+    m_u32HeadOffset += in_u32RecordSize;
+
+    return;
+}
+
+/**
+ * @brief Starts the compaction at the sector following the head and skips the sectors compacted before a restart
+ */
+static void Storage_ResetCompaction(void)
+{
+    m_u32CompactSector = (m_u32HeadSector + 1U) % LOG_NUMBER_OF_SECTORS;
+    m_u32CompactOffset = SECTOR_HEADER_SIZE_IN_BYTES;
+
+    /* The quotas of the interrupted lap are not known, a new one is started */
+    Storage_StartLap();
+
+    while ((COMPACTION_LOOKAHEAD_IN_SECTORS >= Storage_GetDistanceFromHead(m_u32CompactSector)) && (E_TRUE == Storage_IsSectorCompacted(m_u32CompactSector)))
+    {
+        Storage_CloseCompactedSector(E_FALSE);
     }
 
-    printf("\n");
+    return;
+}
+
+/**
+ * @brief Starts a new lap of the quotas, it lasts until the compaction reaches the copies made in it
+ */
+static void Storage_StartLap(void)
+{
+    uint32_t u32IterSeverity = COMMON_STARTING_INDEX_OF_ARRAY;
+
+    for (; EVENTHANDLER_NUMBER_OF_EVENT_SEVERITIES > u32IterSeverity; u32IterSeverity++)
+    {
+        m_au32CarriedRecordsInLap[u32IterSeverity] = 0U;
+    }
+
+    m_u32LapEndSector = m_u32HeadSector;
+
+    return;
+}
+
+/**
+ * @brief Visits at most COMPACTION_SLICE_IN_RECORDS records (or sector ends) ahead of the head and carries the retained ones
+ */
+static void Storage_CompactSlice(void)
+{
+    uint8_t au8Record[RECORD_MAX_SIZE_IN_BYTES];
+    uint32_t u32RecordSize = 0U;
+    uint32_t u32RecordAddress = LOG_START_ADDRESS;
+    uint32_t u32IterSlice = COMMON_STARTING_INDEX_OF_ARRAY;
+    uint32_t u32Distance = Storage_GetDistanceFromHead(m_u32CompactSector);
+    RecordState_e eRecordState = E_RECORD_ERASED;
+
+    for (; (COMPACTION_SLICE_IN_RECORDS > u32IterSlice) && (0U != u32Distance) && (COMPACTION_LOOKAHEAD_IN_SECTORS >= u32Distance); u32IterSlice++)
+    {
+        eRecordState = E_RECORD_ERASED;
+        u32RecordAddress = Storage_GetSectorAddress(m_u32CompactSector) + m_u32CompactOffset;
+
+        if ((m_u32CompactOffset + RECORD_HEADER_SIZE_IN_BYTES) <= NVMMEM_SECTOR_SIZE_IN_BYTES)
+        {
+            eRecordState = Storage_ReadRecord(u32RecordAddress, au8Record, &u32RecordSize);
+        }
+
+        if (E_RECORD_VALID == eRecordState)
+        {
+            m_u32CompactOffset += u32RecordSize;
+            Storage_CarryRecord(u32RecordAddress, au8Record, u32RecordSize);
+        }
+        else
+        {
+            /* Nothing was written after a torn record either */
+            Storage_CloseCompactedSector(E_TRUE);
+        }
+
+        u32Distance = Storage_GetDistanceFromHead(m_u32CompactSector);
+    }
+
+    return;
+}
+
+/**
+ * @brief Copies the record to the head if its severity is retained and its quota is not used up yet
+ *
+ * @param in_u32Address      Address of the record in the sector being compacted
+ * @param inout_pu8Record    Record with its header and checksum, flagged as a copy when carried
+ * @param in_u32RecordSize   Size of the whole record in bytes
+ */
+static void Storage_CarryRecord(uint32_t in_u32Address, uint8_t *inout_pu8Record, uint32_t in_u32RecordSize)
+{
+    uint32_t u32DataSize = in_u32RecordSize - RECORD_HEADER_SIZE_IN_BYTES - RECORD_CHECKSUM_SIZE_IN_BYTES;
+    uint32_t u32Severity = EVENTHANDLER_NUMBER_OF_EVENT_SEVERITIES;
+    uint32_t u32CompactSector = m_u32CompactSector;
+    uint8_t u8Flags = inout_pu8Record[RECORD_FLAGS_OFFSET];
+    uint8_t u8Generations = (uint8_t) (u8Flags & RECORD_FLAGS_GENERATIONS);
+
+    if ((EVENTHANDLER_REPORT_SEVERITY_OFFSET + COMMON_UINT32_SIZE_IN_BYTES) <= u32DataSize)
+    {
+        u32Severity = EventHandler_ReadWord(&inout_pu8Record[RECORD_HEADER_SIZE_IN_BYTES + EVENTHANDLER_REPORT_SEVERITY_OFFSET]);
+    }
+
+    /* Records of unknown layout, of not retained severities and the already copied ones are left to be erased */
+    if ((EVENTHANDLER_NUMBER_OF_EVENT_SEVERITIES <= u32Severity) || (0U == m_au32RetentionQuota[u32Severity]) || (0U == (RECORD_FLAG_CARRIED & u8Flags)))
+    {
+        return;
+    }
+
+    if (STORAGE_RETENTION_MAX_CARRIES <= Storage_GetRecordGeneration(u8Flags))
+    {
+        m_sRetentionStatistics.au32ExpiredRecords[u32Severity]++;
+        return;
+    }
+
+    if (m_au32RetentionQuota[u32Severity] <= m_au32CarriedRecordsInLap[u32Severity])
+    {
+        m_sRetentionStatistics.au32DroppedRecords[u32Severity]++;
+        return;
+    }
+
+    m_au32CarriedRecordsInLap[u32Severity]++;
+    m_sRetentionStatistics.au32CarriedRecords[u32Severity]++;
+
+    /* The flags are excluded from the checksum, the copy is told apart from the reports written in its sector by them
+       and its generation is counted by clearing the lowest generation bit still set */
+    inout_pu8Record[RECORD_FLAGS_OFFSET] = (uint8_t) (u8Flags & (uint8_t) ~RECORD_FLAG_COPY & (uint8_t) ~(u8Generations & (uint8_t) (0U - u8Generations)));
+    Storage_AppendRecord(inout_pu8Record, in_u32RecordSize);
+
+    /* Flagged only after the copy is written, an interrupted carry duplicates the record instead of losing it */
+    if (u32CompactSector == m_u32CompactSector)
+    {
+        u8Flags &= (uint8_t) ~RECORD_FLAG_CARRIED;
+        NvmMem_Write(in_u32Address + RECORD_FLAGS_OFFSET, &u8Flags, sizeof(u8Flags));
+    }
+
+    return;
+}
+
+/**
+ * @brief Gives how many times the report in the record has been copied
+ *
+ * @param in_u8Flags   Flags of the record
+ *
+ * @return             Number of the cleared generation bits
+ */
+static uint32_t Storage_GetRecordGeneration(uint8_t in_u8Flags)
+{
+    uint32_t u32Generation = 0U;
+    uint8_t u8ClearedBits = (uint8_t) (~in_u8Flags & RECORD_FLAGS_GENERATIONS);
+
+    while (0U != u8ClearedBits)
+    {
+        u8ClearedBits &= (uint8_t) (u8ClearedBits - 1U);
+        u32Generation++;
+    }
+
+    return u32Generation;
+}
+
+/**
+ * @brief Moves the compaction to the next sector, starts a new lap of the quotas on reaching the copies of the current one
+ *
+ * @param in_bIsCompacted   E_TRUE if the sector was compacted completely and is marked so
+ */
+static void Storage_CloseCompactedSector(boolean in_bIsCompacted)
+{
+    uint8_t au8State[COMMON_UINT32_SIZE_IN_BYTES];
+    uint32_t u32Sequence = INITIAL_SEQUENCE_NUMBER;
+
+    if ((E_TRUE == in_bIsCompacted) && (E_TRUE == Storage_ReadSectorSequence(m_u32CompactSector, &u32Sequence)))
+    {
+        Storage_WriteWord(au8State, SECTOR_STATE_COMPACTED);
+        NvmMem_Write(Storage_GetSectorAddress(m_u32CompactSector) + SECTOR_HEADER_STATE_OFFSET, au8State, COMMON_UINT32_SIZE_IN_BYTES);
+        m_sRetentionStatistics.u32ReclaimedSectors++;
+    }
+
+    m_u32CompactSector = (m_u32CompactSector + 1U) % LOG_NUMBER_OF_SECTORS;
+    m_u32CompactOffset = SECTOR_HEADER_SIZE_IN_BYTES;
+
+    /* A copy is carried at most once per lap, which a lap fixed to the sector indexes would not ensure,
+       as the copies land a few sectors behind the compaction */
+    if (m_u32LapEndSector == m_u32CompactSector)
+    {
+        Storage_StartLap();
+    }
+
+    return;
+}
+
+/**
+ * @brief Checks the state word of the sector header
+ *
+ * @param in_u32Sector   Index of the sector in the log
+ *
+ * @return E_FALSE       The sector has not been compacted in this lap
+ * @return E_TRUE        The sector has been compacted in this lap
+ */
+static boolean Storage_IsSectorCompacted(uint32_t in_u32Sector)
+{
+    uint8_t au8State[COMMON_UINT32_SIZE_IN_BYTES];
+    uint32_t u32IterBytes = COMMON_STARTING_INDEX_OF_ARRAY;
+
+    /* Reads as not compacted if the memory access fails */
+    for (; COMMON_UINT32_SIZE_IN_BYTES > u32IterBytes; u32IterBytes++)
+    {
+        au8State[u32IterBytes] = NVMMEM_ERASED_BYTE;
+    }
+
+    NvmMem_Read(Storage_GetSectorAddress(in_u32Sector) + SECTOR_HEADER_STATE_OFFSET, au8State, COMMON_UINT32_SIZE_IN_BYTES);
+
+    return (SECTOR_STATE_COMPACTED == EventHandler_ReadWord(au8State)) ? E_TRUE : E_FALSE;
+}
+
+/**
+ * @brief Reads the sequence number of the report in the record, a copy made by the compaction included
+ *
+ * @param in_pu8Record              Record with its header and checksum
+ * @param in_u32RecordSize          Size of the whole record in bytes
+ * @param out_pu32SequenceNumber    Sequence number of the report
+ *
+ * @return E_FALSE                  The record holds no sequence number
+ * @return E_TRUE                   The sequence number is valid
+ */
+static boolean Storage_ReadReportSequenceNumber(const uint8_t *in_pu8Record, uint32_t in_u32RecordSize, uint32_t *out_pu32SequenceNumber)
+{
+    boolean bIsValid = E_FALSE;
+
+    if ((RECORD_HEADER_SIZE_IN_BYTES + EVENTHANDLER_REPORT_SEQUENCE_OFFSET + COMMON_UINT32_SIZE_IN_BYTES + RECORD_CHECKSUM_SIZE_IN_BYTES) <= in_u32RecordSize)
+    {
+        *out_pu32SequenceNumber = EventHandler_ReadWord(&in_pu8Record[RECORD_HEADER_SIZE_IN_BYTES + EVENTHANDLER_REPORT_SEQUENCE_OFFSET]);
+        bIsValid = E_TRUE;
+    }
+
+    return bIsValid;
+}
+
+/**
+ * @brief Tells whether the record is a copy made by the compaction
+ *
+ * @param in_pu8Record   Record with its header and checksum
+ *
+ * @return E_FALSE       The record holds a report written into its sector
+ * @return E_TRUE        The record is a copy
+ */
+static boolean Storage_IsRecordCopy(const uint8_t *in_pu8Record)
+{
+    return (0U == (RECORD_FLAG_COPY & in_pu8Record[RECORD_FLAGS_OFFSET])) ? E_TRUE : E_FALSE;
+}
+
+/**
+ * @brief Moves the sequence number following the newest stored report past the report in the record
+ *
+ * @param in_pu8Record       Record with its header and checksum
+ * @param in_u32RecordSize   Size of the whole record in bytes
+ */
+static void Storage_UpdateNextSequenceNumber(const uint8_t *in_pu8Record, uint32_t in_u32RecordSize)
+{
+    uint32_t u32SequenceNumber = INITIAL_SEQUENCE_NUMBER;
+
+    if (E_TRUE == Storage_ReadReportSequenceNumber(in_pu8Record, in_u32RecordSize, &u32SequenceNumber))
+    {
+        if ((E_FALSE == m_bIsNextSequenceNumberKnown) || (u32SequenceNumber >= m_u32NextSequenceNumber))
+        {
+            m_u32NextSequenceNumber = u32SequenceNumber + 1U;
+            m_bIsNextSequenceNumberKnown = E_TRUE;
+        }
+    }
+
+    return;
+}
+
+/**
+ * @brief Reads the sequence number of the first report written into the sector
+ *
+ * @param in_u32Sector              Index of the sector in the log
+ * @param out_pu32SequenceNumber    Sequence number of the first report
+ *
+ * @return E_FALSE                  The sector is not valid or holds no report (only copies)
+ * @return E_TRUE                   The sequence number is valid
+ */
+static boolean Storage_ReadFirstReportSequenceNumber(uint32_t in_u32Sector, uint32_t *out_pu32SequenceNumber)
+{
+    uint8_t au8Index[COMMON_UINT32_SIZE_IN_BYTES];
+    uint32_t u32IterBytes = COMMON_STARTING_INDEX_OF_ARRAY;
+    uint32_t u32Sequence = INITIAL_SEQUENCE_NUMBER;
+    boolean bIsValid = E_FALSE;
+
+    if (E_TRUE == Storage_ReadSectorSequence(in_u32Sector, &u32Sequence))
+    {
+        /* Reads as not indexed if the memory access fails */
+        for (; COMMON_UINT32_SIZE_IN_BYTES > u32IterBytes; u32IterBytes++)
+        {
+            au8Index[u32IterBytes] = NVMMEM_ERASED_BYTE;
+        }
+
+        NvmMem_Read(Storage_GetSectorAddress(in_u32Sector) + SECTOR_HEADER_FIRST_REPORT_OFFSET, au8Index, COMMON_UINT32_SIZE_IN_BYTES);
+
+        if (ERASED_WORD != EventHandler_ReadWord(au8Index))
+        {
+            *out_pu32SequenceNumber = EventHandler_ReadWord(au8Index);
+            bIsValid = E_TRUE;
+        }
+    }
+
+    return bIsValid;
+}
+
+/**
+ * @brief Hands the reports of the sector with sequence numbers in the range over to the receiver
+ *        and moves the sequence number following the newest stored report past them
+ *
+ * A copy already carried again is skipped, its newer copy stands in for it; a carry interrupted
+ * before the flagging leaves both copies to be handed over.
+ *
+ * @param in_u32Sector                Index of the sector in the log
+ * @param in_u32FirstSequenceNumber   First sequence number of the range
+ * @param in_u32LastSequenceNumber    Last sequence number of the range (included)
+ * @param in_pfReceiver               Receiver of the reports, NULL if the sector is only scanned
+ * @param in_bAreCopiesLoaded         E_TRUE to hand over the copies only, E_FALSE for the reports written into the sector
+ *
+ * @return                            Number of the reports handed over
+ */
+static uint32_t Storage_LoadSectorReports(uint32_t in_u32Sector, uint32_t in_u32FirstSequenceNumber, uint32_t in_u32LastSequenceNumber, EventHandler_Sink_f in_pfReceiver, boolean in_bAreCopiesLoaded)
+{
+    uint8_t au8Record[RECORD_MAX_SIZE_IN_BYTES];
+    uint32_t u32RecordSize = 0U;
+    uint32_t u32Offset = SECTOR_HEADER_SIZE_IN_BYTES;
+    uint32_t u32SequenceNumber = INITIAL_SEQUENCE_NUMBER;
+    uint32_t u32NumberOfReports = 0U;
+    RecordState_e eRecordState = E_RECORD_ERASED;
+
+    if (E_FALSE == Storage_ReadSectorSequence(in_u32Sector, &u32SequenceNumber))
+    {
+        return u32NumberOfReports;
+    }
+
+    do
+    {
+        eRecordState = E_RECORD_ERASED;
+
+        if ((u32Offset + RECORD_HEADER_SIZE_IN_BYTES) <= NVMMEM_SECTOR_SIZE_IN_BYTES)
+        {
+            eRecordState = Storage_ReadRecord(Storage_GetSectorAddress(in_u32Sector) + u32Offset, au8Record, &u32RecordSize);
+        }
+
+        if (E_RECORD_VALID == eRecordState)
+        {
+            Storage_UpdateNextSequenceNumber(au8Record, u32RecordSize);
+
+            if ((NULL != in_pfReceiver) && (E_TRUE == Storage_ReadReportSequenceNumber(au8Record, u32RecordSize, &u32SequenceNumber)) &&
+                (in_u32FirstSequenceNumber <= u32SequenceNumber) && (in_u32LastSequenceNumber >= u32SequenceNumber) &&
+                (in_bAreCopiesLoaded == Storage_IsRecordCopy(au8Record)) && ((E_FALSE == in_bAreCopiesLoaded) || (0U != (RECORD_FLAG_CARRIED & au8Record[RECORD_FLAGS_OFFSET]))))
+            {
+                in_pfReceiver(&au8Record[RECORD_HEADER_SIZE_IN_BYTES], u32RecordSize - RECORD_HEADER_SIZE_IN_BYTES - RECORD_CHECKSUM_SIZE_IN_BYTES);
+                u32NumberOfReports++;
+            }
+
+            u32Offset += u32RecordSize;
+        }
+    } while (E_RECORD_VALID == eRecordState);
+
+    return u32NumberOfReports;
+}
+
+/**
+ * @brief Gives the number of sectors from the head forward to the sector
+ *
+ * @param in_u32Sector   Index of the sector in the log
+ *
+ * @return               Distance, 0 for the head itself
+ */
+static uint32_t Storage_GetDistanceFromHead(uint32_t in_u32Sector)
+{
+    return ((in_u32Sector + LOG_NUMBER_OF_SECTORS) - m_u32HeadSector) % LOG_NUMBER_OF_SECTORS;
+}
+
+/**
+ * @brief Gives the written sector of the age
+ *
+ * @param in_u32Age    Age of the sector, 0 for the oldest written one
+ *
+ * @return             Index of the sector in the log
+ */
+static uint32_t Storage_GetSectorOfAge(uint32_t in_u32Age)
+{
+    return (m_u32HeadSector + 1U + (LOG_NUMBER_OF_SECTORS - m_u32NumberOfUsedSectors) + in_u32Age) % LOG_NUMBER_OF_SECTORS;
+}
+
+/**
+ * @brief Reads and validates one record of the log
+ *
+ * @param in_u32Address         Address of the record
+ * @param out_pu8Record         Buffer of RECORD_MAX_SIZE_IN_BYTES for the whole record
+ * @param out_pu32RecordSize    Size of the whole record in bytes, valid for E_RECORD_VALID only
+ *
+ * @return                      State of the record
+ */
+static RecordState_e Storage_ReadRecord(uint32_t in_u32Address, uint8_t *out_pu8Record, uint32_t *out_pu32RecordSize)
+{
+    RecordState_e eRecordState = E_RECORD_TORN;
+    uint32_t u32IterBytes = COMMON_STARTING_INDEX_OF_ARRAY;
+    uint32_t u32Header = ERASED_WORD;
+    uint32_t u32DataSize = 0U;
+    uint8_t u8Flags = RECORD_FLAGS_UNSET;
+    uint32_t u32SectorEnd = (in_u32Address - (in_u32Address % NVMMEM_SECTOR_SIZE_IN_BYTES)) + NVMMEM_SECTOR_SIZE_IN_BYTES;
+
+    /* Reads as erased memory if the memory access fails */
+    for (; RECORD_MAX_SIZE_IN_BYTES > u32IterBytes; u32IterBytes++)
+    {
+        out_pu8Record[u32IterBytes] = NVMMEM_ERASED_BYTE;
+    }
+
+    NvmMem_Read(in_u32Address, out_pu8Record, RECORD_HEADER_SIZE_IN_BYTES);
+    u32Header = EventHandler_ReadWord(out_pu8Record);
+    u32DataSize = u32Header & RECORD_LENGTH_MASK;
+
+    if (ERASED_WORD == u32Header)
+    {
+        eRecordState = E_RECORD_ERASED;
+    }
+    else if ((RECORD_MARKER == (u32Header >> RECORD_MARKER_SHIFT)) && (0U != u32DataSize) && (RECORD_MAX_DATA_SIZE_IN_BYTES >= u32DataSize) &&
+             ((in_u32Address + RECORD_HEADER_SIZE_IN_BYTES + u32DataSize + RECORD_CHECKSUM_SIZE_IN_BYTES) <= u32SectorEnd))
+    {
+        NvmMem_Read(in_u32Address + RECORD_HEADER_SIZE_IN_BYTES, &out_pu8Record[RECORD_HEADER_SIZE_IN_BYTES], u32DataSize + RECORD_CHECKSUM_SIZE_IN_BYTES);
+
+        /* The flags are programmed after the record was written, so the checksum covers them unset */
+        u8Flags = out_pu8Record[RECORD_FLAGS_OFFSET];
+        out_pu8Record[RECORD_FLAGS_OFFSET] = RECORD_FLAGS_UNSET;
+
+        if (Storage_CalculateChecksum(out_pu8Record, RECORD_HEADER_SIZE_IN_BYTES + u32DataSize) == EventHandler_ReadWord(&out_pu8Record[RECORD_HEADER_SIZE_IN_BYTES + u32DataSize]))
+        {
+            *out_pu32RecordSize = RECORD_HEADER_SIZE_IN_BYTES + u32DataSize + RECORD_CHECKSUM_SIZE_IN_BYTES;
+            eRecordState = E_RECORD_VALID;
+        }
+
+        out_pu8Record[RECORD_FLAGS_OFFSET] = u8Flags;
+    }
+    else
+    {
+        ;
+    }
+
+    return eRecordState;
+}
+
+/**
+ * @brief Gives the NVM address of a sector of the log
+ *
+ * @param in_u32Sector   Index of the sector in the log
+ *
+ * @return               Start address of the sector
+ */
+static uint32_t Storage_GetSectorAddress(uint32_t in_u32Sector)
+{
+    return LOG_START_ADDRESS + (in_u32Sector * NVMMEM_SECTOR_SIZE_IN_BYTES);
+}
+
+/**
+ * @brief Calculates the CRC-32 checksum of the data
+ *
+ * @param in_pu8Data       Data array
+ * @param in_u32DataSize   Size of the data in bytes
+ *
+ * @return                 Checksum of the data
+ */
+static uint32_t Storage_CalculateChecksum(const uint8_t *in_pu8Data, uint32_t in_u32DataSize)
+{
+    uint32_t u32Checksum = CHECKSUM_INITIAL_VALUE;
+    uint32_t u32IterBytes = COMMON_STARTING_INDEX_OF_ARRAY;
+    uint32_t u32IterBits = COMMON_STARTING_INDEX_OF_ARRAY;
+
+    for (; in_u32DataSize > u32IterBytes; u32IterBytes++)
+    {
+        u32Checksum ^= in_pu8Data[u32IterBytes];
+
+        for (u32IterBits = COMMON_STARTING_INDEX_OF_ARRAY; COMMON_BYTE_SIZE_IN_BITS > u32IterBits; u32IterBits++)
+        {
+            u32Checksum = (u32Checksum >> 1U) ^ (CHECKSUM_POLYNOMIAL & (0U - (u32Checksum & 1U)));
+        }
+    }
+
+    return ~u32Checksum;
+}
+
+/**
+ * @brief Writes a 32-bit number into 4 bytes, the most significant byte first
+ *
+ * @param out_pu8Data   Target array of at least 4 bytes
+ * @param in_u32Word    Number to be written
+ */
+static void Storage_WriteWord(uint8_t *out_pu8Data, uint32_t in_u32Word)
+{
+    uint32_t u32IterBytes = COMMON_UINT32_SIZE_IN_BYTES;
+
+    while (0U < u32IterBytes)
+    {
+        u32IterBytes--;
+        out_pu8Data[u32IterBytes] = (uint8_t) (in_u32Word & EXTRACT_ONE_BYTE);
+        in_u32Word >>= COMMON_BYTE_SIZE_IN_BITS;
+    }
 
     return;
 }
@@ -21,6 +21,29 @@
 #define __STORAGE_H__
 
 #include "Common.h"
+#include "EventHandler.h"
+
+/* Records of each severity carried forward during one lap of the log by default */
+#define STORAGE_DEFAULT_QUOTA_LOW          0U
+#define STORAGE_DEFAULT_QUOTA_NORMAL       32U
+#define STORAGE_DEFAULT_QUOTA_MEDIUM       128U
+/* Copies of a retained report at most (up to 6), its last copy is overwritten one lap later */
+#define STORAGE_RETENTION_MAX_CARRIES      2U
+
+/* Counters of the retention since the start */
+typedef struct
+{
+    uint32_t au32CarriedRecords[EVENTHANDLER_NUMBER_OF_EVENT_SEVERITIES];   /* Records copied ahead of the write head */
+    uint32_t au32DroppedRecords[EVENTHANDLER_NUMBER_OF_EVENT_SEVERITIES];   /* Records not carried because the quota was used up */
+    uint32_t au32ExpiredRecords[EVENTHANDLER_NUMBER_OF_EVENT_SEVERITIES];   /* Copies not carried again after STORAGE_RETENTION_MAX_CARRIES copies */
+    uint32_t u32ReclaimedSectors;                                           /* Sectors compacted before their erasure */
+    uint32_t u32OverrunSectors;                                             /* Sectors erased before the compactor finished them */
+} Storage_RetentionStatistics_s;
+
+/**
+ * @brief The function recovers the write head of the event log in local memory.
+ */
+void Storage_Initialize(void);
 
 /**
  * @brief The function stores event report in local memory.
@@ -30,4 +53,39 @@
  */
 void Storage_StoreEventReport(const uint8_t *in_pu8EventData, uint32_t in_u32DataSize);
 
+/**
+ * @brief The function gives the sequence number following the newest stored report.
+ *
+ * @return    Sequence number of the next report, 0 for an empty log
+ */
+uint32_t Storage_GetNextSequenceNumber(void);
+
+/**
+ * @brief The function hands the stored reports with sequence numbers in the range over to the receiver, the oldest first.
+ *        The retained copies of the overwritten reports go first in the order of the log, a copying interrupted
+ *        by a reset may hand such a report over twice.
+ *
+ * @param in_u32FirstSequenceNumber   First sequence number of the range
+ * @param in_u32LastSequenceNumber    Last sequence number of the range (included)
+ * @param in_pfReceiver               Receiver of the reports, e.g. Comm_SendEventReport
+ *
+ * @return                            Number of the reports handed over
+ */
+uint32_t Storage_LoadEventReports(uint32_t in_u32FirstSequenceNumber, uint32_t in_u32LastSequenceNumber, EventHandler_Sink_f in_pfReceiver);
+
+/**
+ * @brief The function sets how many reports of the severity are carried forward during one lap of the log.
+ *
+ * @param in_eSeverity               Event severity
+ * @param in_u32MaxCarriedRecords    Quota of the severity, 0 lets the reports be overwritten
+ */
+void Storage_SetRetentionQuota(EventHandler_Severity_e in_eSeverity, uint32_t in_u32MaxCarriedRecords);
+
+/**
+ * @brief The function gives the counters of the retention.
+ *
+ * @param out_psStatistics    Counters of the retention
+ */
+void Storage_GetRetentionStatistics(Storage_RetentionStatistics_s *out_psStatistics);
+
 #endif /* __STORAGE_H__ */
@@ -0,0 +1,613 @@
+/*
+ ******************************************************************************
+ *                                                                            *
+ *                              Michal Durila                                 *
+ *                                                                            *
+ *                                                                            *
+ *                           ALL RIGHTS RESERVED                              *
+ *                                                                            *
+ ******************************************************************************
+ */
+
+/**
+ *  @file TraceExport.c
+ *  @author Michal Durila
+ *  @brief This module converts event reports into a Perfetto trace, which timeline viewers load directly.
+ *
+ * The trace is a sequence of TracePacket messages (protobuf), written as they are composed. Each
+ * module gets its own track, described before its first event, and each report becomes an instant
+ * event named by the event type, with the severity as its category and the location, the additional
+ * data, the sequence number and the context data as its annotations. A report is converted on its
+ * own, so the memory used does not depend on the length of the log and one pass over it is enough.
+ *
+ * The report times count from the start of the system, so a time going back while the sequence
+ * number goes on marks the next boot. The boots are laid one after another on the timeline, each
+ * shifted by the last time of the ones before, and the index of the boot is annotated to every event.
+ * The retained copies, which the event log hands over first in the order they were copied, may go
+ * back in the sequence numbers; such a copy is put on the current boot and marks no boot.
+ *
+ * Copyright 2021 Michal Durila, All rights reserved.
+ */
+
+#include "TraceExport.h"
+#include "Modules.h"
+#include "Storage.h"
+
+
+#define UNINITIALIZED_COUNTER            0U
+#define FIRST_SEQUENCE_NUMBER            0U
+#define LAST_SEQUENCE_NUMBER             0xFFFFFFFFU
+#define NANOSECONDS_IN_SECOND            1000000000.0
+
+/* Protobuf encoding */
+#define WIRE_TYPE_VARINT                 0U
+#define WIRE_TYPE_LENGTH_DELIMITED       2U
+#define WIRE_TYPE_BITS                   3U
+#define VARINT_PAYLOAD_MASK              0x7FU
+#define VARINT_CONTINUATION_BIT          0x80U
+#define VARINT_PAYLOAD_BITS              7U
+#define VARINT_MAX_SIZE_IN_BYTES         10U
+#define HEX_DIGITS_PER_BYTE              2U
+#define HEX_DIGIT_BITS                   4U
+#define HEX_DIGIT_MASK                   0x0FU
+
+/* Fields of the Perfetto messages used (perfetto/trace/trace.proto and the messages it includes) */
+#define TRACE_PACKET                     1U
+#define PACKET_TIMESTAMP                 8U
+#define PACKET_TRUSTED_SEQUENCE_ID       10U
+#define PACKET_TRACK_EVENT               11U
+#define PACKET_SEQUENCE_FLAGS            13U
+#define PACKET_TRACK_DESCRIPTOR          60U
+#define TRACK_DESCRIPTOR_UUID            1U
+#define TRACK_DESCRIPTOR_NAME            2U
+#define TRACK_EVENT_DEBUG_ANNOTATIONS    4U
+#define TRACK_EVENT_TYPE                 9U
+#define TRACK_EVENT_TRACK_UUID           11U
+#define TRACK_EVENT_CATEGORIES           22U
+#define TRACK_EVENT_NAME                 23U
+#define DEBUG_ANNOTATION_UINT_VALUE      3U
+#define DEBUG_ANNOTATION_STRING_VALUE    6U
+#define DEBUG_ANNOTATION_NAME            10U
+#define TRACK_EVENT_TYPE_INSTANT         3U
+#define SEQUENCE_INCREMENTAL_STATE_CLEARED 1U
+#define TRUSTED_SEQUENCE_ID              1U
+
+/* Track of a module is TRACK_UUID_BASE + module ID, unknown modules share the track after the last one */
+#define TRACK_UUID_BASE                  0x4556000000000000ULL
+#define UNKNOWN_MODULE_TRACK             MODULES_NUMBER_OF_IDS
+#define NUMBER_OF_MODULE_NAMES           (sizeof(m_apcModuleNames) / sizeof(m_apcModuleNames[COMMON_STARTING_INDEX_OF_ARRAY]))
+
+/* Sizes of the composed messages, a report with the longest context data fits with a margin */
+#define ANNOTATION_MAX_SIZE_IN_BYTES     (32U + (HEX_DIGITS_PER_BYTE * EVENTHANDLER_CONTEXT_DATA_MAX_SIZE_IN_BYTES))
+#define TRACK_EVENT_MAX_SIZE_IN_BYTES    (128U + (5U * ANNOTATION_MAX_SIZE_IN_BYTES))
+#define PACKET_MAX_SIZE_IN_BYTES         (32U + TRACK_EVENT_MAX_SIZE_IN_BYTES)
+
+/* Module ID assignment */
+static const Modules_Id_e m_eModuleId = E_MODULES_ID_TRACEEXPORT;
+
+/* Typedef containing all defined event instances in this module */
+typedef enum
+{
+    E_EVENT_INSTANCE_TRACEEXPORT_START_NULL              = 0U,
+    E_EVENT_INSTANCE_TRACEEXPORT_EXPORTREPORT_NULL       = 1U,
+    E_EVENT_INSTANCE_TRACEEXPORT_EXPORTREPORT_CONTEXTSIZE = 2U,
+    E_EVENT_INSTANCE_TRACEEXPORT_STOP_DATASIZE           = 3U,
+    E_EVENT_INSTANCE_TRACEEXPORT_MODULES                 = 4U
+} EventInstance_e;
+
+/* An auxiliary union defined for the conversion of an array of bytes into a 64-bit float variable */
+typedef union
+{
+    float64_t f64Number;
+    uint8_t au8Number[COMMON_FLOAT64_SIZE_IN_BYTES];
+} ConversionByteToFloat_u;
+
+/* Names of the tracks, indexed by the module ID */
+static const char * const m_apcModuleNames[] =
+{
+    "Module 0", "Comm", "Storage", "NvmMem", "Common", "Modules", "EventHandler", "SystemReset",
+    "Timing", "EventStatistics", "EventHitters", "SinkWorker", "TraceExport", "Simulator"
+};
+static const char * const m_pcUnknownModuleName = "Unknown module";
+
+/* Names of the events and of their categories */
+static const char * const m_apcTypeNames[EVENTHANDLER_NUMBER_OF_EVENT_TYPES + 1U] =
+{
+    "NULLARGUMENT", "MINDATALENGTH", "ADDRESSRANGE", "DIVISIONBYZERO", "UNUPDATEDCONSTANTS", "UNKNOWNTYPE"
+};
+static const char * const m_apcSeverityNames[EVENTHANDLER_NUMBER_OF_EVENT_SEVERITIES + 1U] =
+{
+    "LOW", "NORMAL", "MEDIUM", "UNKNOWNSEVERITY"
+};
+
+static TraceExport_Writer_f m_pfWriter = NULL;
+static boolean m_bIsSequenceStarted;
+static uint32_t m_u32DescribedTracks;
+static uint32_t m_u32NumberOfReports;
+
+/* Last report in the order of the sequence numbers, its time in the current boot and the shift of its times on the timeline */
+static boolean m_bIsLastReportKnown;
+static uint32_t m_u32LastSequenceNumber;
+static float64_t m_f64LastTimeInSeconds;
+static float64_t m_f64BootOffsetInSeconds;
+static uint32_t m_u32BootIndex;
+
+/* Beginning of a report split between two calls */
+static uint8_t m_au8PendingReport[TRACEEXPORT_REPORT_MAX_SIZE_IN_BYTES];
+static uint32_t m_u32PendingReportSize;
+
+static void TraceExport_StopOnInvalidReport(const uint8_t *in_pu8Report);
+static void TraceExport_ConvertReport(const uint8_t *in_pu8Report, uint32_t in_u32ContextDataSize);
+static void TraceExport_DescribeTrack(uint32_t in_u32Track);
+static void TraceExport_WritePacket(const uint8_t *in_pu8Packet, uint32_t in_u32PacketSize);
+static void TraceExport_PutVarint(uint64_t in_u64Number, uint8_t **inout_ppu8Data, const uint8_t * const in_pu8DataBoundary);
+static void TraceExport_PutVarintField(uint32_t in_u32Field, uint64_t in_u64Number, uint8_t **inout_ppu8Data, const uint8_t * const in_pu8DataBoundary);
+static void TraceExport_PutBytesField(uint32_t in_u32Field, const uint8_t *in_pu8Bytes, uint32_t in_u32NumberOfBytes, uint8_t **inout_ppu8Data, const uint8_t * const in_pu8DataBoundary);
+static void TraceExport_PutStringField(uint32_t in_u32Field, const char *in_pcString, uint8_t **inout_ppu8Data, const uint8_t * const in_pu8DataBoundary);
+static void TraceExport_PutAnnotation(const char *in_pcName, uint32_t in_u32Value, const uint8_t *in_pu8HexValue, uint32_t in_u32HexValueSize, uint8_t **inout_ppu8Data, const uint8_t * const in_pu8DataBoundary);
+
+
+/**
+ * @brief Starts a new trace handed over to the writer, a trace being exported is finished first
+ *
+ * @param in_pfWriter   Receiver of the trace data
+ */
+void TraceExport_Start(TraceExport_Writer_f in_pfWriter)
+{
+    if (NULL == in_pfWriter)
+    {
+        EventHandler_GenerateEventReport(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_TRACEEXPORT_START_NULL, E_EVENTHANDLER_SEVERITY_MEDIUM, E_EVENTHANDLER_TYPE_NULLARGUMENT);
+        return;
+    }
+
+    if (NULL != m_pfWriter)
+    {
+        (void) TraceExport_Stop();
+    }
+
+    m_pfWriter = in_pfWriter;
+    m_bIsSequenceStarted = E_FALSE;
+    m_u32DescribedTracks = UNINITIALIZED_COUNTER;
+    m_u32NumberOfReports = UNINITIALIZED_COUNTER;
+    m_u32PendingReportSize = UNINITIALIZED_COUNTER;
+    m_bIsLastReportKnown = E_FALSE;
+    m_u32LastSequenceNumber = FIRST_SEQUENCE_NUMBER;
+    m_f64LastTimeInSeconds = 0.0;
+    m_f64BootOffsetInSeconds = 0.0;
+    m_u32BootIndex = UNINITIALIZED_COUNTER;
+
+    return;
+}
+
+/**
+ * @brief Converts the reports into trace packets, it is a sink of the event reports.
+ *        The data may be a stream cut at any place, e.g. a captured Comm stream read in blocks.
+ *        A report declaring more context data than a report may carry finishes the trace,
+ *        as the following reports cannot be told apart any more.
+ *
+ * @param in_pu8EventData   Event report data array, reports back to back
+ * @param in_u32DataSize    Size of event report data in bytes
+ */
+void TraceExport_ExportReport(const uint8_t *in_pu8EventData, uint32_t in_u32DataSize)
+{
+    uint32_t u32IterBytes = COMMON_STARTING_INDEX_OF_ARRAY;
+    uint32_t u32ReportSize = EVENTHANDLER_REPORT_SIZE_IN_BYTES;
+
+    if (NULL == in_pu8EventData)
+    {
+        EventHandler_GenerateEventReport(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_TRACEEXPORT_EXPORTREPORT_NULL, E_EVENTHANDLER_SEVERITY_MEDIUM, E_EVENTHANDLER_TYPE_NULLARGUMENT);
+        return;
+    }
+
+    if (NULL == m_pfWriter)
+    {
+        return;
+    }
+
+    while ((NULL != m_pfWriter) && (in_u32DataSize > u32IterBytes))
+    {
+        if ((UNINITIALIZED_COUNTER == m_u32PendingReportSize) && ((in_u32DataSize - u32IterBytes) >= EVENTHANDLER_REPORT_SIZE_IN_BYTES) &&
+            ((in_u32DataSize - u32IterBytes) >= EventHandler_GetReportSize(&in_pu8EventData[u32IterBytes])))
+        {
+            /* A whole report, converted in place */
+            u32ReportSize = EventHandler_GetReportSize(&in_pu8EventData[u32IterBytes]);
+
+            if (EVENTHANDLER_INVALID_REPORT_SIZE == u32ReportSize)
+            {
+                TraceExport_StopOnInvalidReport(&in_pu8EventData[u32IterBytes]);
+            }
+            else
+            {
+                TraceExport_ConvertReport(&in_pu8EventData[u32IterBytes], u32ReportSize - EVENTHANDLER_REPORT_SIZE_IN_BYTES);
+                u32IterBytes += u32ReportSize;
+            }
+        }
+        else
+        {
+            /* The report continues in the next call, its size is known once its fixed part is complete */
+            u32ReportSize = EVENTHANDLER_REPORT_SIZE_IN_BYTES;
+
+            if (EVENTHANDLER_REPORT_SIZE_IN_BYTES <= m_u32PendingReportSize)
+            {
+                u32ReportSize = EventHandler_GetReportSize(m_au8PendingReport);
+            }
+
+            m_au8PendingReport[m_u32PendingReportSize] = in_pu8EventData[u32IterBytes];
+            m_u32PendingReportSize++;
+            u32IterBytes++;
+
+            if ((EVENTHANDLER_REPORT_SIZE_IN_BYTES == m_u32PendingReportSize) || (u32ReportSize == m_u32PendingReportSize))
+            {
+                u32ReportSize = EventHandler_GetReportSize(m_au8PendingReport);
+
+                if (EVENTHANDLER_INVALID_REPORT_SIZE == u32ReportSize)
+                {
+                    TraceExport_StopOnInvalidReport(m_au8PendingReport);
+                }
+                else if (u32ReportSize == m_u32PendingReportSize)
+                {
+                    TraceExport_ConvertReport(m_au8PendingReport, u32ReportSize - EVENTHANDLER_REPORT_SIZE_IN_BYTES);
+                    m_u32PendingReportSize = UNINITIALIZED_COUNTER;
+                }
+                else
+                {
+                    ;
+                }
+            }
+        }
+    }
+
+    return;
+}
+
+/**
+ * @brief Finishes the trace
+ *
+ * @return   Number of the exported reports
+ */
+uint32_t TraceExport_Stop(void)
+{
+    if (UNINITIALIZED_COUNTER != m_u32PendingReportSize)
+    {
+        /* The data ended inside a report */
+        EventHandler_GenerateEventReportUserData(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_TRACEEXPORT_STOP_DATASIZE, E_EVENTHANDLER_SEVERITY_LOW, E_EVENTHANDLER_TYPE_MINDATALENGTH, m_u32PendingReportSize);
+        m_u32PendingReportSize = UNINITIALIZED_COUNTER;
+    }
+
+    m_pfWriter = NULL;
+
+    return m_u32NumberOfReports;
+}
+
+/**
+ * @brief Exports the whole event log stored by Storage as one trace, the oldest report first,
+ *        the retained copies of the overwritten reports included
+ *
+ * @param in_pfWriter   Receiver of the trace data
+ *
+ * @return              Number of the exported reports
+ */
+uint32_t TraceExport_ExportEventLog(TraceExport_Writer_f in_pfWriter)
+{
+    uint32_t u32NumberOfReports = UNINITIALIZED_COUNTER;
+
+    TraceExport_Start(in_pfWriter);
+
+    if (NULL != m_pfWriter)
+    {
+        (void) Storage_LoadEventReports(FIRST_SEQUENCE_NUMBER, LAST_SEQUENCE_NUMBER, TraceExport_ExportReport);
+        u32NumberOfReports = TraceExport_Stop();
+    }
+
+    return u32NumberOfReports;
+}
+
+/**
+ * @brief Finishes the trace at a report of an invalid context data size, where the report boundaries of the stream are lost
+ *
+ * @param in_pu8Report   Report of at least EVENTHANDLER_REPORT_SIZE_IN_BYTES
+ */
+static void TraceExport_StopOnInvalidReport(const uint8_t *in_pu8Report)
+{
+    EventHandler_GenerateEventReportUserData(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_TRACEEXPORT_EXPORTREPORT_CONTEXTSIZE, E_EVENTHANDLER_SEVERITY_LOW, E_EVENTHANDLER_TYPE_ADDRESSRANGE, EventHandler_ReadWord(&in_pu8Report[EVENTHANDLER_REPORT_CONTEXT_SIZE_OFFSET]));
+    m_u32PendingReportSize = UNINITIALIZED_COUNTER;
+    (void) TraceExport_Stop();
+
+    return;
+}
+
+/**
+ * @brief Writes the report as an instant event on the track of its module, the track is described first if needed
+ *
+ * @param in_pu8Report             Report followed by its context data
+ * @param in_u32ContextDataSize    Size of the context data in bytes
+ */
+static void TraceExport_ConvertReport(const uint8_t *in_pu8Report, uint32_t in_u32ContextDataSize)
+{
+    ConversionByteToFloat_u uAuxiliaryConversion;
+    uint8_t au8TrackEvent[TRACK_EVENT_MAX_SIZE_IN_BYTES];
+    uint8_t au8Packet[PACKET_MAX_SIZE_IN_BYTES];
+    uint8_t *pu8Data = au8TrackEvent;
+    uint32_t u32IterBytes = COMMON_STARTING_INDEX_OF_ARRAY;
+    uint32_t u32Track = EventHandler_ReadWord(&in_pu8Report[EVENTHANDLER_REPORT_MODULE_OFFSET]);
+    uint32_t u32Severity = EventHandler_ReadWord(&in_pu8Report[EVENTHANDLER_REPORT_SEVERITY_OFFSET]);
+    uint32_t u32Type = EventHandler_ReadWord(&in_pu8Report[EVENTHANDLER_REPORT_TYPE_OFFSET]);
+    uint32_t u32SequenceNumber = EventHandler_ReadWord(&in_pu8Report[EVENTHANDLER_REPORT_SEQUENCE_OFFSET]);
+    uint64_t u64TimestampInNanoseconds = 0U;
+
+    if (MODULES_NUMBER_OF_IDS <= u32Track)
+    {
+        u32Track = UNKNOWN_MODULE_TRACK;
+    }
+
+    if (EVENTHANDLER_NUMBER_OF_EVENT_SEVERITIES < u32Severity)
+    {
+        u32Severity = EVENTHANDLER_NUMBER_OF_EVENT_SEVERITIES;
+    }
+
+    if (EVENTHANDLER_NUMBER_OF_EVENT_TYPES < u32Type)
+    {
+        u32Type = EVENTHANDLER_NUMBER_OF_EVENT_TYPES;
+    }
+
+    for (; COMMON_FLOAT64_SIZE_IN_BYTES > u32IterBytes; u32IterBytes++)
+    {
+        uAuxiliaryConversion.au8Number[u32IterBytes] = in_pu8Report[EVENTHANDLER_REPORT_TIME_OFFSET + u32IterBytes];
+    }
+
+    /* Reports of an unknown time are put at the start of the current boot */
+    if (0.0 < uAuxiliaryConversion.f64Number)
+    {
+        if ((E_FALSE == m_bIsLastReportKnown) || (u32SequenceNumber > m_u32LastSequenceNumber))
+        {
+            if (m_f64LastTimeInSeconds > uAuxiliaryConversion.f64Number)
+            {
+                m_f64BootOffsetInSeconds += m_f64LastTimeInSeconds;
+                m_u32BootIndex++;
+            }
+
+            m_bIsLastReportKnown = E_TRUE;
+            m_u32LastSequenceNumber = u32SequenceNumber;
+            m_f64LastTimeInSeconds = uAuxiliaryConversion.f64Number;
+        }
+    }
+    else
+    {
+        uAuxiliaryConversion.f64Number = 0.0;
+    }
+
+    u64TimestampInNanoseconds = (uint64_t) ((m_f64BootOffsetInSeconds + uAuxiliaryConversion.f64Number) * NANOSECONDS_IN_SECOND);
+
+    if (0U == (m_u32DescribedTracks & (1U << u32Track)))
+    {
+        TraceExport_DescribeTrack(u32Track);
+    }
+
+    TraceExport_PutVarintField(TRACK_EVENT_TYPE, TRACK_EVENT_TYPE_INSTANT, &pu8Data, &au8TrackEvent[TRACK_EVENT_MAX_SIZE_IN_BYTES]);
+    TraceExport_PutVarintField(TRACK_EVENT_TRACK_UUID, TRACK_UUID_BASE + u32Track, &pu8Data, &au8TrackEvent[TRACK_EVENT_MAX_SIZE_IN_BYTES]);
+    TraceExport_PutStringField(TRACK_EVENT_CATEGORIES, m_apcSeverityNames[u32Severity], &pu8Data, &au8TrackEvent[TRACK_EVENT_MAX_SIZE_IN_BYTES]);
+    TraceExport_PutStringField(TRACK_EVENT_NAME, m_apcTypeNames[u32Type], &pu8Data, &au8TrackEvent[TRACK_EVENT_MAX_SIZE_IN_BYTES]);
+    TraceExport_PutAnnotation("location", EventHandler_ReadWord(&in_pu8Report[EVENTHANDLER_REPORT_LOCATION_OFFSET]), NULL, 0U, &pu8Data, &au8TrackEvent[TRACK_EVENT_MAX_SIZE_IN_BYTES]);
+    TraceExport_PutAnnotation("data", EventHandler_ReadWord(&in_pu8Report[EVENTHANDLER_REPORT_DATA_OFFSET]), NULL, 0U, &pu8Data, &au8TrackEvent[TRACK_EVENT_MAX_SIZE_IN_BYTES]);
+    TraceExport_PutAnnotation("sequence", u32SequenceNumber, NULL, 0U, &pu8Data, &au8TrackEvent[TRACK_EVENT_MAX_SIZE_IN_BYTES]);
+    TraceExport_PutAnnotation("boot", m_u32BootIndex, NULL, 0U, &pu8Data, &au8TrackEvent[TRACK_EVENT_MAX_SIZE_IN_BYTES]);
+
+    if (0U != in_u32ContextDataSize)
+    {
+        TraceExport_PutAnnotation("context", 0U, &in_pu8Report[EVENTHANDLER_REPORT_SIZE_IN_BYTES], in_u32ContextDataSize, &pu8Data, &au8TrackEvent[TRACK_EVENT_MAX_SIZE_IN_BYTES]);
+    }
+
+    u32IterBytes = (uint32_t) (pu8Data - au8TrackEvent);
+    pu8Data = au8Packet;
+    TraceExport_PutVarintField(PACKET_TIMESTAMP, u64TimestampInNanoseconds, &pu8Data, &au8Packet[PACKET_MAX_SIZE_IN_BYTES]);
+    TraceExport_PutVarintField(PACKET_TRUSTED_SEQUENCE_ID, TRUSTED_SEQUENCE_ID, &pu8Data, &au8Packet[PACKET_MAX_SIZE_IN_BYTES]);
+    TraceExport_PutBytesField(PACKET_TRACK_EVENT, au8TrackEvent, u32IterBytes, &pu8Data, &au8Packet[PACKET_MAX_SIZE_IN_BYTES]);
+    TraceExport_WritePacket(au8Packet, (uint32_t) (pu8Data - au8Packet));
+
+    m_u32NumberOfReports++;
+
+    return;
+}
+
+/**
+ * @brief Writes the descriptor of the track of the module, the first packet of the trace clears the state of the viewer as well
+ *
+ * @param in_u32Track   Module ID or UNKNOWN_MODULE_TRACK
+ */
+static void TraceExport_DescribeTrack(uint32_t in_u32Track)
+{
+    uint8_t au8TrackDescriptor[TRACK_EVENT_MAX_SIZE_IN_BYTES];
+    uint8_t au8Packet[PACKET_MAX_SIZE_IN_BYTES];
+    uint8_t *pu8Data = au8TrackDescriptor;
+    uint32_t u32TrackDescriptorSize = 0U;
+    const char *pcName = m_pcUnknownModuleName;
+
+    if (NUMBER_OF_MODULE_NAMES > in_u32Track)
+    {
+        pcName = m_apcModuleNames[in_u32Track];
+    }
+    else if (UNKNOWN_MODULE_TRACK != in_u32Track)
+    {
+        /* Someone may have forgotten to add the name of a new module */
+        EventHandler_GenerateEventReportUserData(m_eModuleId, (uint32_t) E_EVENT_INSTANCE_TRACEEXPORT_MODULES, E_EVENTHANDLER_SEVERITY_NORMAL, E_EVENTHANDLER_TYPE_UNUPDATEDCONSTANTS, in_u32Track);
+    }
+    else
+    {
+        ;
+    }
+
+    TraceExport_PutVarintField(TRACK_DESCRIPTOR_UUID, TRACK_UUID_BASE + in_u32Track, &pu8Data, &au8TrackDescriptor[TRACK_EVENT_MAX_SIZE_IN_BYTES]);
+    TraceExport_PutStringField(TRACK_DESCRIPTOR_NAME, pcName, &pu8Data, &au8TrackDescriptor[TRACK_EVENT_MAX_SIZE_IN_BYTES]);
+    u32TrackDescriptorSize = (uint32_t) (pu8Data - au8TrackDescriptor);
+
+    pu8Data = au8Packet;
+    TraceExport_PutVarintField(PACKET_TRUSTED_SEQUENCE_ID, TRUSTED_SEQUENCE_ID, &pu8Data, &au8Packet[PACKET_MAX_SIZE_IN_BYTES]);
+
+    if (E_FALSE == m_bIsSequenceStarted)
+    {
+        TraceExport_PutVarintField(PACKET_SEQUENCE_FLAGS, SEQUENCE_INCREMENTAL_STATE_CLEARED, &pu8Data, &au8Packet[PACKET_MAX_SIZE_IN_BYTES]);
+        m_bIsSequenceStarted = E_TRUE;
+    }
+
+    TraceExport_PutBytesField(PACKET_TRACK_DESCRIPTOR, au8TrackDescriptor, u32TrackDescriptorSize, &pu8Data, &au8Packet[PACKET_MAX_SIZE_IN_BYTES]);
+    TraceExport_WritePacket(au8Packet, (uint32_t) (pu8Data - au8Packet));
+
+    m_u32DescribedTracks |= 1U << in_u32Track;
+
+    return;
+}
+
+/**
+ * @brief Hands the packet over to the writer as one entry of the trace
+ *
+ * @param in_pu8Packet       Composed TracePacket
+ * @param in_u32PacketSize   Size of the packet in bytes
+ */
+static void TraceExport_WritePacket(const uint8_t *in_pu8Packet, uint32_t in_u32PacketSize)
+{
+    uint8_t au8Prefix[VARINT_MAX_SIZE_IN_BYTES + VARINT_MAX_SIZE_IN_BYTES];
+    uint8_t *pu8Data = au8Prefix;
+
+    TraceExport_PutVarint((TRACE_PACKET << WIRE_TYPE_BITS) | WIRE_TYPE_LENGTH_DELIMITED, &pu8Data, &au8Prefix[sizeof(au8Prefix)]);
+    TraceExport_PutVarint(in_u32PacketSize, &pu8Data, &au8Prefix[sizeof(au8Prefix)]);
+
+    m_pfWriter(au8Prefix, (uint32_t) (pu8Data - au8Prefix));
+    m_pfWriter(in_pu8Packet, in_u32PacketSize);
+
+    return;
+}
+
+/**
+ * @brief Puts the number as a varint, nothing is put if it does not fit
+ *
+ * @param in_u64Number          Number to be put
+ * @param inout_ppu8Data        Position in the array, moved after the number
+ * @param in_pu8DataBoundary    End of the array
+ */
+static void TraceExport_PutVarint(uint64_t in_u64Number, uint8_t **inout_ppu8Data, const uint8_t * const in_pu8DataBoundary)
+{
+    if ((in_pu8DataBoundary - *inout_ppu8Data) >= (long) VARINT_MAX_SIZE_IN_BYTES)
+    {
+        while (VARINT_PAYLOAD_MASK < in_u64Number)
+        {
+            **inout_ppu8Data = (uint8_t) ((in_u64Number & VARINT_PAYLOAD_MASK) | VARINT_CONTINUATION_BIT);
+            (*inout_ppu8Data)++;
+            in_u64Number >>= VARINT_PAYLOAD_BITS;
+        }
+
+        **inout_ppu8Data = (uint8_t) in_u64Number;
+        (*inout_ppu8Data)++;
+    }
+
+    return;
+}
+
+/**
+ * @brief Puts the field holding a number, nothing is put if it does not fit
+ *
+ * @param in_u32Field           Field number
+ * @param in_u64Number          Number to be put
+ * @param inout_ppu8Data        Position in the array, moved after the field
+ * @param in_pu8DataBoundary    End of the array
+ */
+static void TraceExport_PutVarintField(uint32_t in_u32Field, uint64_t in_u64Number, uint8_t **inout_ppu8Data, const uint8_t * const in_pu8DataBoundary)
+{
+    /* A key without its number would shift the rest of the message */
+    if ((in_pu8DataBoundary - *inout_ppu8Data) >= (long) (VARINT_MAX_SIZE_IN_BYTES + VARINT_MAX_SIZE_IN_BYTES))
+    {
+        TraceExport_PutVarint((in_u32Field << WIRE_TYPE_BITS) | WIRE_TYPE_VARINT, inout_ppu8Data, in_pu8DataBoundary);
+        TraceExport_PutVarint(in_u64Number, inout_ppu8Data, in_pu8DataBoundary);
+    }
+
+    return;
+}
+
+/**
+ * @brief Puts the field holding bytes or a nested message, nothing is put if it does not fit
+ *
+ * @param in_u32Field           Field number
+ * @param in_pu8Bytes           Bytes to be put
+ * @param in_u32NumberOfBytes   Number of the bytes
+ * @param inout_ppu8Data        Position in the array, moved after the field
+ * @param in_pu8DataBoundary    End of the array
+ */
+static void TraceExport_PutBytesField(uint32_t in_u32Field, const uint8_t *in_pu8Bytes, uint32_t in_u32NumberOfBytes, uint8_t **inout_ppu8Data, const uint8_t * const in_pu8DataBoundary)
+{
+    uint32_t u32IterBytes = COMMON_STARTING_INDEX_OF_ARRAY;
+
+    if ((in_pu8DataBoundary - *inout_ppu8Data) >= (long) (VARINT_MAX_SIZE_IN_BYTES + VARINT_MAX_SIZE_IN_BYTES + in_u32NumberOfBytes))
+    {
+        TraceExport_PutVarint((in_u32Field << WIRE_TYPE_BITS) | WIRE_TYPE_LENGTH_DELIMITED, inout_ppu8Data, in_pu8DataBoundary);
+        TraceExport_PutVarint(in_u32NumberOfBytes, inout_ppu8Data, in_pu8DataBoundary);
+
+        for (; in_u32NumberOfBytes > u32IterBytes; u32IterBytes++)
+        {
+            **inout_ppu8Data = in_pu8Bytes[u32IterBytes];
+            (*inout_ppu8Data)++;
+        }
+    }
+
+    return;
+}
+
+/**
+ * @brief Puts the field holding a string
+ *
+ * @param in_u32Field           Field number
+ * @param in_pcString           Zero terminated string
+ * @param inout_ppu8Data        Position in the array, moved after the field
+ * @param in_pu8DataBoundary    End of the array
+ */
+static void TraceExport_PutStringField(uint32_t in_u32Field, const char *in_pcString, uint8_t **inout_ppu8Data, const uint8_t * const in_pu8DataBoundary)
+{
+    uint32_t u32Length = 0U;
+
+    while ('\0' != in_pcString[u32Length])
+    {
+        u32Length++;
+    }
+
+    TraceExport_PutBytesField(in_u32Field, (const uint8_t *) in_pcString, u32Length, inout_ppu8Data, in_pu8DataBoundary);
+
+    return;
+}
+
+/**
+ * @brief Puts a debug annotation of the event, holding a number or the bytes written as hexadecimal digits
+ *
+ * @param in_pcName             Name of the annotation
+ * @param in_u32Value           Number, used if there are no bytes
+ * @param in_pu8HexValue        Bytes, NULL for the number
+ * @param in_u32HexValueSize    Number of the bytes
+ * @param inout_ppu8Data        Position in the array, moved after the annotation
+ * @param in_pu8DataBoundary    End of the array
+ */
+static void TraceExport_PutAnnotation(const char *in_pcName, uint32_t in_u32Value, const uint8_t *in_pu8HexValue, uint32_t in_u32HexValueSize, uint8_t **inout_ppu8Data, const uint8_t * const in_pu8DataBoundary)
+{
+    static const uint8_t au8HexDigits[] = "0123456789ABCDEF";
+    uint8_t au8Annotation[ANNOTATION_MAX_SIZE_IN_BYTES];
+    uint8_t au8HexValue[HEX_DIGITS_PER_BYTE * EVENTHANDLER_CONTEXT_DATA_MAX_SIZE_IN_BYTES];
+    uint8_t *pu8Data = au8Annotation;
+    uint32_t u32IterBytes = COMMON_STARTING_INDEX_OF_ARRAY;
+
+    TraceExport_PutStringField(DEBUG_ANNOTATION_NAME, in_pcName, &pu8Data, &au8Annotation[ANNOTATION_MAX_SIZE_IN_BYTES]);
+
+    if (NULL == in_pu8HexValue)
+    {
+        TraceExport_PutVarintField(DEBUG_ANNOTATION_UINT_VALUE, in_u32Value, &pu8Data, &au8Annotation[ANNOTATION_MAX_SIZE_IN_BYTES]);
+    }
+    else
+    {
+        for (; (in_u32HexValueSize > u32IterBytes) && (EVENTHANDLER_CONTEXT_DATA_MAX_SIZE_IN_BYTES > u32IterBytes); u32IterBytes++)
+        {
+            au8HexValue[HEX_DIGITS_PER_BYTE * u32IterBytes] = au8HexDigits[in_pu8HexValue[u32IterBytes] >> HEX_DIGIT_BITS];
+            au8HexValue[(HEX_DIGITS_PER_BYTE * u32IterBytes) + 1U] = au8HexDigits[in_pu8HexValue[u32IterBytes] & HEX_DIGIT_MASK];
+        }
+
+        TraceExport_PutBytesField(DEBUG_ANNOTATION_STRING_VALUE, au8HexValue, HEX_DIGITS_PER_BYTE * u32IterBytes, &pu8Data, &au8Annotation[ANNOTATION_MAX_SIZE_IN_BYTES]);
+    }
+
+    TraceExport_PutBytesField(TRACK_EVENT_DEBUG_ANNOTATIONS, au8Annotation, (uint32_t) (pu8Data - au8Annotation), inout_ppu8Data, in_pu8DataBoundary);
+
+    return;
+}
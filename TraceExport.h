@@ -0,0 +1,67 @@
+/*
+ ******************************************************************************
+ *                                                                            *
+ *                              Michal Durila                                 *
+ *                                                                            *
+ *                                                                            *
+ *                           ALL RIGHTS RESERVED                              *
+ *                                                                            *
+ ******************************************************************************
+ */
+
+/**
+ *  @file TraceExport.h
+ *  @author Michal Durila
+ *  @brief This module converts event reports into a Perfetto trace, which timeline viewers load directly.
+ *
+ * Copyright 2021 Michal Durila, All rights reserved.
+ */
+
+#ifndef __TRACEEXPORT_H__
+#define __TRACEEXPORT_H__
+
+#include "Common.h"
+#include "EventHandler.h"
+
+/* Longest report with its context data, a report split between two calls is completed in a buffer of this size */
+#define TRACEEXPORT_REPORT_MAX_SIZE_IN_BYTES (EVENTHANDLER_REPORT_SIZE_IN_BYTES + EVENTHANDLER_CONTEXT_DATA_MAX_SIZE_IN_BYTES)
+
+/* Receiver of the trace data, e.g. a file writer, the data are valid during the call only */
+typedef void (*TraceExport_Writer_f)(const uint8_t *in_pu8TraceData, uint32_t in_u32DataSize);
+
+/**
+ * @brief Starts a new trace handed over to the writer, a trace being exported is finished first
+ *
+ * @param in_pfWriter   Receiver of the trace data
+ */
+void TraceExport_Start(TraceExport_Writer_f in_pfWriter);
+
+/**
+ * @brief Converts the reports into trace packets, it is a sink of the event reports.
+ *        The data may be a stream cut at any place, e.g. a captured Comm stream read in blocks.
+ *        A report declaring more context data than a report may carry finishes the trace,
+ *        as the following reports cannot be told apart any more.
+ *
+ * @param in_pu8EventData   Event report data array, reports back to back
+ * @param in_u32DataSize    Size of event report data in bytes
+ */
+void TraceExport_ExportReport(const uint8_t *in_pu8EventData, uint32_t in_u32DataSize);
+
+/**
+ * @brief Finishes the trace
+ *
+ * @return   Number of the exported reports
+ */
+uint32_t TraceExport_Stop(void);
+
+/**
+ * @brief Exports the whole event log stored by Storage as one trace, the oldest report first,
+ *        the retained copies of the overwritten reports included
+ *
+ * @param in_pfWriter   Receiver of the trace data
+ *
+ * @return              Number of the exported reports
+ */
+uint32_t TraceExport_ExportEventLog(TraceExport_Writer_f in_pfWriter);
+
+#endif /* __TRACEEXPORT_H__ */